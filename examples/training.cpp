@@ -64,7 +64,7 @@ int main()
         // parse the manifest and display the AI training status
 
         bool allowed = true; // default to allowed
-        json manifest_store = json::parse(new_manifest_json.value());
+        json manifest_store = json::parse(new_manifest_json.value().view());
 
         // get the active manifest
         string active_manifest = manifest_store["active_manifest"];
@@ -36,6 +36,194 @@
 
 #endif
 
+// When linking a library built without the signing feature
+// (make release-verify), define C2PA_VERIFY_ONLY before including this
+// header to hide the signing declarations
+#if !defined(C2PA_VERIFY_ONLY)
+    #define C2PA_SIGNING
+#endif
+
+/**
+ * Read flag to skip writing thumbnails and other binary resources to the data_dir
+ */
+#define C2PA_READ_SKIP_RESOURCES 1
+
+/**
+ * Read flag to skip generating a thumbnail for ingredients that do not carry one
+ */
+#define C2PA_READ_SKIP_THUMBNAILS 2
+
+#if defined(C2PA_SIGNING)
+/**
+ * Sign flag declaring the source asset is known to be unsigned, skipping
+ * the parent manifest detection pass over the source
+ */
+#define C2PA_SIGN_SKIP_PARENT_CHECK 1
+#endif
+
+/**
+ * Stable numeric codes identifying each Error variant over the C API
+ *
+ * These values are published in c2pa.h and must never be renumbered,
+ * only appended to.
+ */
+typedef enum C2paErrorCode {
+  C2paErrorNone = 0,
+  C2paErrorAssertion = 1,
+  C2paErrorAssertionNotFound = 2,
+  C2paErrorDecoding = 3,
+  C2paErrorEncoding = 4,
+  C2paErrorFileNotFound = 5,
+  C2paErrorIo = 6,
+  C2paErrorJson = 7,
+  C2paErrorManifest = 8,
+  C2paErrorManifestNotFound = 9,
+  C2paErrorNotSupported = 10,
+  C2paErrorOther = 11,
+  C2paErrorNullParameter = 12,
+  C2paErrorRemoteManifest = 13,
+  C2paErrorResourceNotFound = 14,
+  C2paErrorSignature = 15,
+  C2paErrorVerify = 16,
+} C2paErrorCode;
+
+/**
+ * Defines the seek modes for the seek callback, matching SEEK_SET, SEEK_CUR and SEEK_END
+ */
+typedef enum C2paSeekMode {
+  Start = 0,
+  Current = 1,
+  End = 2,
+} C2paSeekMode;
+
+/**
+ * Identifies the phase of a read or sign call reported to a trace callback.
+ *
+ * These values are published in c2pa.h and recorded by external tracing
+ * systems; never renumber or remove an entry, only append new ones.
+ */
+typedef enum C2paTraceStage {
+  /**
+   * Parsing and validating a manifest store on the read path
+   */
+  C2paTraceReadManifest = 0,
+  /**
+   * Parsing a manifest definition JSON on the sign path
+   */
+  C2paTraceManifestParse = 1,
+  /**
+   * Parsing the certificates and private key into a signer
+   */
+  C2paTraceSignerParse = 2,
+  /**
+   * Hashing the asset, signing the claim and writing the output
+   */
+  C2paTraceEmbed = 3,
+  /**
+   * A timestamp authority round trip (cache hits are not reported)
+   */
+  C2paTraceTimestamp = 4,
+  /**
+   * The chunked read/hash pipeline over asset byte ranges
+   */
+  C2paTraceDataHash = 5,
+} C2paTraceStage;
+
+#if defined(C2PA_SIGNING)
+/**
+ * An opaque handle holding a precomputed Ingredient
+ *
+ * Building the ingredient reads and hashes the asset; doing it once and
+ * passing the handle to a sign call avoids the hidden second pass over the
+ * source that parent detection would otherwise make.
+ */
+typedef struct C2paIngredient C2paIngredient;
+#endif
+
+#if defined(C2PA_SIGNING)
+/**
+ * An opaque handle holding a compiled manifest template
+ *
+ * The manifest definition JSON is parsed and validated once when the handle
+ * is created, removing a serde pass from every sign call that reuses it.
+ */
+typedef struct C2paManifestTemplate C2paManifestTemplate;
+#endif
+
+/**
+ * An opaque handle holding a cache of verification results
+ *
+ * Results are keyed by (file size, mtime, manifest box hash), so a cached
+ * report is only returned while the asset and its manifest store are
+ * unchanged. The handle is safe to share across threads.
+ */
+typedef struct C2paReaderCache C2paReaderCache;
+
+#if defined(C2PA_SIGNING)
+/**
+ * An opaque handle holding a reusable signer
+ *
+ * The certificates and private key are parsed once when the handle is
+ * created so they do not need to be re-parsed on every sign call.
+ */
+typedef struct C2paSigner C2paSigner;
+#endif
+
+#if defined(C2PA_SIGNING)
+/**
+ * A long lived signing session over an internal worker pool
+ * (see c2pa_signer_session_create)
+ */
+typedef struct C2paSignerSession C2paSignerSession;
+#endif
+
+/**
+ * An opaque context passed through to the stream callbacks
+ *
+ * The C caller owns the context and is responsible for its lifetime.
+ */
+typedef struct StreamContext {
+
+} StreamContext;
+
+/**
+ * Reads up to len bytes into data, returning the number of bytes read or a negative value on error
+ */
+typedef intptr_t (*ReadCallback)(struct StreamContext *context, uint8_t *data, uintptr_t len);
+
+/**
+ * Seeks to offset using the given mode, returning the new position or a negative value on error
+ */
+typedef int64_t (*SeekCallback)(struct StreamContext *context,
+                                int64_t offset,
+                                enum C2paSeekMode mode);
+
+/**
+ * Writes len bytes from data, returning the number of bytes written or a negative value on error
+ */
+typedef intptr_t (*WriteCallback)(struct StreamContext *context, const uint8_t *data, uintptr_t len);
+
+/**
+ * Flushes any buffered writes, returning zero or a negative value on error
+ */
+typedef int64_t (*FlushCallback)(struct StreamContext *context);
+
+/**
+ * A C2paStream is a Rust Read/Write/Seek stream that can be created in C
+ * from a context pointer and a set of callbacks
+ *
+ * This allows the library to read and write assets held by the caller
+ * (for example in object storage) without any temporary files.
+ */
+typedef struct C2paStream {
+  struct StreamContext *context;
+  ReadCallback reader;
+  SeekCallback seeker;
+  WriteCallback writer;
+  FlushCallback flusher;
+} C2paStream;
+
+#if defined(C2PA_SIGNING)
 /**
  * Defines the configuration for a Signer
  *
@@ -61,6 +249,7 @@ typedef struct C2paSignerInfo {
    */
   const char *ta_url;
 } C2paSignerInfo;
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -84,6 +273,87 @@ IMPORT extern char *c2pa_version(void);
  */
 IMPORT extern char *c2pa_error(void);
 
+/**
+ * Returns the numeric code of the last error
+ *
+ * Unlike c2pa_error this performs no formatting or allocation, so hot
+ * paths can classify common failures such as C2paErrorManifestNotFound
+ * without string matching. Returns C2paErrorNone if no error has occurred.
+ *
+ * # Safety
+ * May be called from any thread; the last error is thread local
+ */
+IMPORT extern enum C2paErrorCode c2pa_error_code(void);
+
+/**
+ * Writes the last error message into a caller buffer
+ *
+ * Unlike c2pa_error nothing needs to be released; an empty string is
+ * written if no error has occurred
+ *
+ * # Errors
+ * Returns the required buffer size in bytes including the null terminator
+ *
+ * # Safety
+ * Writes at most buf_len bytes to buf, which may be NULL to query the size
+ */
+IMPORT extern int64_t c2pa_error_into(char *buf, uintptr_t buf_len);
+
+/**
+ * Enables or disables memory mapped reads for the file based read paths
+ *
+ * While enabled, c2pa_read_file and the other file based readers map the
+ * asset into memory and parse it in place instead of copying it through
+ * buffered reads; off by default
+ *
+ * # Safety
+ * May be called from any thread at any time
+ */
+IMPORT extern void c2pa_set_mmap_read(bool enabled);
+
+/**
+ * Applies one named library setting
+ *
+ * Known keys are "mmap_read", "hash_chunk_size", "hash_readahead_chunks"
+ * and "timestamp_cache_ttl"; the last three exist only when the library is
+ * built with signing support
+ *
+ * # Errors
+ * Returns -1 for an unknown key, otherwise 0
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * Reads from a null terminated C string
+ * May be called from any thread at any time
+ */
+IMPORT extern int c2pa_settings_set(const char *key, uint64_t value);
+
+/**
+ * Applies a flat JSON object of settings, e.g.
+ * {"hash_chunk_size": 4194304, "mmap_read": true}
+ *
+ * Values must be unsigned integers or booleans. The whole object is
+ * validated before anything is applied, so a rejected load leaves every
+ * setting unchanged
+ *
+ * # Errors
+ * Returns -1 for invalid JSON, an unknown key or a bad value, otherwise 0
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * Reads from a null terminated C string
+ * May be called from any thread at any time
+ */
+IMPORT extern int c2pa_settings_load(const char *json);
+
+/**
+ * Restores every library setting to its built-in default
+ *
+ * # Safety
+ * May be called from any thread at any time
+ */
+IMPORT extern void c2pa_settings_reset(void);
+
 /**
  * Returns a ManifestStore JSON string from a file path.
  * Any thumbnails or other binary resources will be written to data_dir if provided
@@ -100,8 +370,154 @@ IMPORT extern char *c2pa_error(void);
 IMPORT extern char *c2pa_read_file(const char *path, const char *data_dir);
 
 /**
- * Returns an Ingredient JSON string from a file path.
- * Any thumbnail or c2pa data will be written to data_dir if provided
+ * Writes a ManifestStore JSON string from a file path into a caller buffer
+ * Any thumbnails or other binary resources will be written to data_dir if provided
+ *
+ * Unlike c2pa_read_file no Rust allocation is handed to the caller, so a
+ * pooled buffer can be reused across calls and nothing needs to be released.
+ * The json is only written, null terminated, when the buffer is large
+ * enough; on a larger return value grow the buffer and call again.
+ *
+ * # Errors
+ * Returns the required buffer size in bytes including the null terminator,
+ * or -1 if there were errors
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * Reads from null terminated C strings
+ * Writes at most buf_len bytes to buf, which may be NULL to query the size
+ */
+IMPORT extern
+int64_t c2pa_read_file_into(const char *path,
+                            const char *data_dir,
+                            char *buf,
+                            uintptr_t buf_len);
+
+/**
+ * Returns a ManifestStore JSON string from an asset in memory.
+ * The format must be a supported mime type or extension (e.g. "image/jpeg" or "jpg")
+ *
+ * # Errors
+ * Returns NULL if there were errors, otherwise returns a JSON string
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * Reads len bytes from the data pointer, which must remain valid for the call
+ * The returned value MUST be released by calling release_string
+ * and it is no longer valid after that call.
+ */
+IMPORT extern char *c2pa_read_buffer(const uint8_t *data, uintptr_t len, const char *format);
+
+/**
+ * Returns a ManifestStore JSON string from a fragmented BMFF asset held in
+ * memory, e.g. one DASH/HLS media segment plus its init segment
+ * Only the two segments are read, so a player can validate fragments as
+ * they arrive instead of concatenating the stream into a monolithic file
+ * The format must be a supported BMFF mime type or extension (e.g.
+ * "video/mp4" or "mp4")
+ *
+ * # Errors
+ * Returns NULL if there were errors, otherwise returns a JSON string
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * Reads init_len and fragment_len bytes from the init_data and
+ * fragment_data pointers, which must remain valid for the call
+ * The returned value MUST be released by calling release_string
+ * and it is no longer valid after that call.
+ */
+IMPORT extern
+char *c2pa_read_fragment(const uint8_t *init_data,
+                         uintptr_t init_len,
+                         const uint8_t *fragment_data,
+                         uintptr_t fragment_len,
+                         const char *format);
+
+/**
+ * Returns a ManifestStore JSON string from a file path, honoring read flags
+ * With C2PA_READ_SKIP_RESOURCES set no thumbnails or other binary resources
+ * are written to data_dir, so metadata-only readers skip that cost
+ *
+ * # Errors
+ * Returns NULL if there were errors, otherwise returns a JSON string
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * Reads from null terminated C strings
+ * The returned value MUST be released by calling release_string
+ * and it is no longer valid after that call.
+ */
+IMPORT extern
+char *c2pa_read_file_with_flags(const char *path,
+                                const char *data_dir,
+                                uint32_t flags);
+
+/**
+ * Writes the ManifestStore JSON report for a file path through the write
+ * callback in chunks
+ *
+ * The report is identical to the one c2pa_read_file returns, but it is
+ * serialized straight into caller chunks of up to 64 KB instead of one
+ * giant string, so peak memory stays bounded no matter how many
+ * ingredients the store carries. No binary resources are written.
+ * The callback returns the number of bytes it consumed, or a negative
+ * value to abort; its data pointer is only valid during the call
+ *
+ * # Errors
+ * Returns -1 if there were errors, otherwise 0
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * Reads from a null terminated C string
+ * The context must remain valid until this call returns
+ */
+IMPORT extern
+int c2pa_read_file_stream(const char *path,
+                          intptr_t (*callback)(const uint8_t *data, uintptr_t len, void *context),
+                          void *context);
+
+/**
+ * Returns a ManifestStore report from a file path as compact CBOR
+ *
+ * The report has the same structure as the JSON from c2pa_read_file but
+ * skips the JSON text round trip, which is faster to parse and smaller on
+ * the wire. The report length is returned via the len parameter. No binary
+ * resources are written.
+ *
+ * # Errors
+ * Returns NULL if there were errors, otherwise returns the CBOR bytes
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * Reads from null terminated C strings
+ * The returned value MUST be released by calling c2pa_release_buffer
+ * and it is no longer valid after that call.
+ */
+IMPORT extern uint8_t *c2pa_read_file_cbor(const char *path, uintptr_t *len);
+
+/**
+ * Returns an Ingredient report from a file path as compact CBOR
+ *
+ * The report has the same structure as the JSON from
+ * c2pa_read_ingredient_file but skips the JSON text round trip. The report
+ * length is returned via the len parameter. No binary resources are written.
+ *
+ * # Errors
+ * Returns NULL if there were errors, otherwise returns the CBOR bytes
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * Reads from null terminated C strings
+ * The returned value MUST be released by calling c2pa_release_buffer
+ * and it is no longer valid after that call.
+ */
+IMPORT extern uint8_t *c2pa_read_ingredient_file_cbor(const char *path, uintptr_t *len);
+
+/**
+ * Returns an Ingredient JSON string from a file path, honoring read flags
+ * With C2PA_READ_SKIP_RESOURCES set no thumbnail or c2pa data is written to
+ * data_dir; with C2PA_READ_SKIP_THUMBNAILS set no thumbnail is decoded or
+ * generated for assets that do not already carry one
  *
  * # Errors
  * Returns NULL if there were errors, otherwise returns a JSON string
@@ -113,14 +529,28 @@ IMPORT extern char *c2pa_read_file(const char *path, const char *data_dir);
  * The returned value MUST be released by calling release_string
  * and it is no longer valid after that call.
  */
-IMPORT extern char *c2pa_read_ingredient_file(const char *path, const char *data_dir);
+IMPORT extern
+char *c2pa_read_ingredient_file_with_flags(const char *path,
+                                           const char *data_dir,
+                                           uint32_t flags);
 
 /**
- * Add a signed manifest to the file at path using auth_token
- * If cloud is true, upload the manifest to the cloud
+ * Returns an Ingredient JSON string from a file path, honoring extraction
+ * options for binary resources
+ *
+ * flags is a combination of the C2PA_READ_* flags.
+ * max_thumbnail_dimension downscales a thumbnail generated from the asset
+ * to that many pixels on its longest edge; zero keeps the default of 1024.
+ * max_resource_bytes drops any resource larger than the cap; zero means no
+ * cap.
+ * When callback is non NULL every extracted resource is delivered through
+ * it instead of being written to disk; the id string and data pointer are
+ * only valid for the duration of the call. Otherwise resources are written
+ * under data_dir, which may be NULL to extract none
  *
  * # Errors
- * Returns an error field if there were errors
+ * Returns NULL if there were errors, otherwise returns a JSON string
+ * The error string can be retrieved by calling c2pa_error
  *
  * # Safety
  * Reads from null terminated C strings
@@ -128,24 +558,838 @@ IMPORT extern char *c2pa_read_ingredient_file(const char *path, const char *data
  * and it is no longer valid after that call.
  */
 IMPORT extern
-char *c2pa_sign_file(const char *source_path,
-                     const char *dest_path,
-                     const char *manifest,
-                     const struct C2paSignerInfo *signer_info,
-                     const char *data_dir);
+char *c2pa_read_ingredient_file_with_options(const char *path,
+                                             const char *data_dir,
+                                             uint32_t flags,
+                                             uint32_t max_thumbnail_dimension,
+                                             uint64_t max_resource_bytes,
+                                             void (*callback)(const char *id,
+                                                              const uint8_t *data,
+                                                              uintptr_t len,
+                                                              void *context),
+                                             void *context);
 
 /**
- * Releases a string allocated by Rust
+ * Returns a JSON object holding only the selected fields of the active manifest
+ * labels is a comma separated list of assertion labels and/or the special
+ * fields "title", "claim_generator" and "validation_status"
+ * Only the requested values are serialized, avoiding the cost of building
+ * and re-parsing a whole ManifestStore report
+ *
+ * # Errors
+ * Returns NULL if there were errors, otherwise returns a JSON string
+ * The error string can be retrieved by calling c2pa_error
  *
  * # Safety
  * Reads from null terminated C strings
- * The string must not have been modified in C
- * can only be released once and is invalid after this call
+ * The returned value MUST be released by calling release_string
+ * and it is no longer valid after that call.
  */
-IMPORT extern void c2pa_release_string(char *s);
+IMPORT extern char *c2pa_read_file_selected(const char *path, const char *labels);
 
-#ifdef __cplusplus
-} // extern "C"
-#endif // __cplusplus
+/**
+ * Returns whether the asset at path contains a C2PA manifest store
+ * Only container headers are scanned; the store is not deserialized or
+ * validated, so this is a fast way to skip assets with no C2PA data
+ *
+ * # Errors
+ * Returns 1 if a manifest store is present, 0 if not, and -1 on error
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * Reads from null terminated C strings
+ */
+IMPORT extern int c2pa_has_manifest(const char *path);
+
+/**
+ * Returns an Ingredient JSON string from a file path.
+ * Any thumbnail or c2pa data will be written to data_dir if provided
+ *
+ * # Errors
+ * Returns NULL if there were errors, otherwise returns a JSON string
+ * containing the Ingredient
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * Reads from null terminated C strings
+ * The returned value MUST be released by calling release_string
+ * and it is no longer valid after that call.
+ */
+IMPORT extern char *c2pa_read_ingredient_file(const char *path, const char *data_dir);
+
+/**
+ * Writes an Ingredient JSON string from a file path into a caller buffer
+ * Any thumbnail or c2pa data will be written to data_dir
+ *
+ * See c2pa_read_file_into for the buffer contract; the json is only
+ * written, null terminated, when the buffer is large enough and nothing
+ * needs to be released.
+ *
+ * # Errors
+ * Returns the required buffer size in bytes including the null terminator,
+ * or -1 if there were errors
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * Reads from null terminated C strings
+ * Writes at most buf_len bytes to buf, which may be NULL to query the size
+ */
+IMPORT extern
+int64_t c2pa_read_ingredient_file_into(const char *path,
+                                       const char *data_dir,
+                                       char *buf,
+                                       uintptr_t buf_len);
+
+/**
+ * Returns a ManifestStore JSON string from a C2paStream
+ * The format must be a supported mime type or extension (e.g. "image/jpeg" or "jpg")
+ *
+ * # Errors
+ * Returns NULL if there were errors, otherwise returns a JSON string
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * The stream must be a valid C2paStream and remains owned by the caller
+ * The returned value MUST be released by calling release_string
+ * and it is no longer valid after that call.
+ */
+IMPORT extern char *c2pa_read_stream(struct C2paStream *stream, const char *format);
+
+/**
+ * Returns an Ingredient JSON string from a C2paStream
+ * The format must be a supported mime type or extension (e.g. "image/jpeg" or "jpg")
+ *
+ * # Errors
+ * Returns NULL if there were errors, otherwise returns a JSON string
+ * containing the Ingredient
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * The stream must be a valid C2paStream and remains owned by the caller
+ * The returned value MUST be released by calling release_string
+ * and it is no longer valid after that call.
+ */
+IMPORT extern char *c2pa_read_ingredient_stream(struct C2paStream *stream, const char *format);
+
+#if defined(C2PA_SIGNING)
+/**
+ * Add a signed manifest read from a source C2paStream and write the signed asset
+ * to a destination C2paStream
+ * The format must be a supported mime type or extension (e.g. "image/jpeg" or "jpg")
+ *
+ * # Errors
+ * Returns NULL if there were errors, otherwise returns an empty string
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * The streams must be valid C2paStreams and remain owned by the caller
+ * The signer handle must be valid and not freed during the call
+ * The returned value MUST be released by calling release_string
+ * and it is no longer valid after that call.
+ */
+IMPORT extern
+char *c2pa_sign_stream(struct C2paStream *source,
+                       struct C2paStream *dest,
+                       const char *format,
+                       const char *manifest,
+                       const struct C2paSigner *signer);
+#endif
+
+#if defined(C2PA_SIGNING)
+/**
+ * Parses and validates a manifest definition JSON into a reusable template handle
+ *
+ * # Errors
+ * Returns NULL if there were errors, otherwise returns a template handle
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * Reads from null terminated C strings
+ * The returned value MUST be released by calling c2pa_manifest_template_free
+ * and it is no longer valid after that call.
+ */
+IMPORT extern struct C2paManifestTemplate *c2pa_manifest_compile(const char *manifest);
+#endif
+
+#if defined(C2PA_SIGNING)
+/**
+ * Add a signed manifest built from a compiled template to the file at path
+ * overlay, if not NULL, is a small JSON object of per-asset top-level fields
+ * (e.g. title) merged over the template
+ * flags accepts C2PA_SIGN_SKIP_PARENT_CHECK
+ *
+ * # Errors
+ * Returns NULL if there were errors, otherwise returns an empty string
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * Reads from null terminated C strings
+ * The template and signer handles must be valid and not freed during the call
+ * The returned value MUST be released by calling release_string
+ * and it is no longer valid after that call.
+ */
+IMPORT extern
+char *c2pa_sign_file_with_template(const char *source_path,
+                                   const char *dest_path,
+                                   const struct C2paManifestTemplate *template_,
+                                   const char *overlay,
+                                   const struct C2paSigner *signer,
+                                   uint32_t flags,
+                                   const char *data_dir);
+#endif
+
+#if defined(C2PA_SIGNING)
+/**
+ * Frees a manifest template handle created by c2pa_manifest_compile
+ *
+ * # Safety
+ * The handle can only be freed once and is invalid after this call
+ */
+IMPORT extern void c2pa_manifest_template_free(struct C2paManifestTemplate *template_);
+#endif
+
+#if defined(C2PA_SIGNING)
+/**
+ * Add a signed manifest to the file at path on a shared worker pool,
+ * invoking the callback when the sign completes
+ * The pool is sized to the available parallelism of the host, so one
+ * thread can keep many signs in flight and timestamp-authority round
+ * trips overlap, while a burst of calls queues instead of spawning an
+ * unbounded number of threads
+ *
+ * # Errors
+ * Returns -1 if the sign could not be started; once 0 is returned the
+ * callback always runs, receiving an error message or NULL on success
+ *
+ * # Safety
+ * Reads from null terminated C strings
+ * The callback may be invoked from another thread and must be thread safe;
+ * its error pointer is only valid during the callback
+ * The context must remain valid until the callback has run
+ */
+IMPORT extern
+int64_t c2pa_sign_file_async(const char *source_path,
+                             const char *dest_path,
+                             const char *manifest,
+                             const struct C2paSignerInfo *signer_info,
+                             const char *data_dir,
+                             void (*callback)(const char *error, void *context),
+                             void *context);
+#endif
+
+#if defined(C2PA_SIGNING)
+/**
+ * Builds an Ingredient from the file at path, returning an opaque handle
+ *
+ * The handle can be passed to c2pa_sign_file_with_ingredient as the parent,
+ * which consumes its contents; a handle can only be used for one sign call
+ *
+ * # Errors
+ * Returns NULL if there were errors, otherwise returns an ingredient handle
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * Reads from null terminated C strings
+ * The returned value MUST be released by calling c2pa_ingredient_free
+ * and it is no longer valid after that call.
+ */
+IMPORT extern struct C2paIngredient *c2pa_ingredient_from_file(const char *path);
+#endif
+
+#if defined(C2PA_SIGNING)
+/**
+ * Add a signed manifest to the file at path using a signer handle and a
+ * precomputed parent ingredient
+ * If parent is not NULL its ingredient is used as the manifest parent and
+ * consumed; if parent is NULL and flags contains C2PA_SIGN_SKIP_PARENT_CHECK
+ * the source is not scanned for an existing manifest store
+ *
+ * # Errors
+ * Returns NULL if there were errors, otherwise returns an empty string
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * Reads from null terminated C strings
+ * The signer and ingredient handles must be valid and not freed during the call
+ * The returned value MUST be released by calling release_string
+ * and it is no longer valid after that call.
+ */
+IMPORT extern
+char *c2pa_sign_file_with_ingredient(const char *source_path,
+                                     const char *dest_path,
+                                     const char *manifest,
+                                     const struct C2paSigner *signer,
+                                     struct C2paIngredient *parent,
+                                     uint32_t flags,
+                                     const char *data_dir);
+#endif
+
+#if defined(C2PA_SIGNING)
+/**
+ * Frees an ingredient handle created by c2pa_ingredient_from_file
+ *
+ * # Safety
+ * The handle can only be freed once and is invalid after this call
+ */
+IMPORT extern void c2pa_ingredient_free(struct C2paIngredient *ingredient);
+#endif
+
+#if defined(C2PA_SIGNING)
+/**
+ * Sets the time to live in seconds for cached timestamp authority responses
+ *
+ * While set, a repeated timestamp request for the same message within the
+ * window is answered from the cache instead of a new round trip to the
+ * timestamp server. Cached responses are only returned for byte identical
+ * messages, so signed output is unaffected. Setting zero (the default)
+ * disables the cache and drops any cached responses.
+ *
+ * # Safety
+ * May be called from any thread at any time
+ */
+IMPORT extern void c2pa_set_timestamp_cache_ttl(uint64_t seconds);
+#endif
+
+/**
+ * Registers a process-wide trace callback reporting per-stage timings of
+ * the read and sign paths, or unregisters it when callback is NULL
+ *
+ * The callback receives the stage identifier (see C2paTraceStage, stable
+ * values suitable for recording), the wall clock start in nanoseconds
+ * since the unix epoch, the elapsed nanoseconds, the payload size in
+ * bytes the stage worked over (0 when not meaningful) and the context.
+ * When no callback is registered the instrumented paths only pay one
+ * atomic load per stage.
+ *
+ * # Safety
+ * The callback may be invoked from any thread, including internal worker
+ * threads, and must be thread safe along with its context
+ * The context must remain valid until the callback is unregistered
+ */
+IMPORT extern void c2pa_set_trace_callback(void (*callback)(enum C2paTraceStage stage,
+                                                            uint64_t start_ns,
+                                                            uint64_t duration_ns,
+                                                            uint64_t bytes,
+                                                            void *context), void *context);
+
+#if defined(C2PA_SIGNING)
+/**
+ * Creates a reusable signer handle from the signer_info fields
+ *
+ * # Errors
+ * Returns NULL if there were errors, otherwise returns a signer handle
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * Reads from null terminated C strings
+ * The returned value MUST be released by calling c2pa_signer_free
+ * and it is no longer valid after that call.
+ */
+IMPORT extern struct C2paSigner *c2pa_signer_create(const struct C2paSignerInfo *signer_info);
+#endif
+
+#if defined(C2PA_SIGNING)
+/**
+ * Add a signed manifest to the file at path using a signer handle
+ * created by c2pa_signer_create
+ *
+ * # Errors
+ * Returns NULL if there were errors, otherwise returns an empty string
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * Reads from null terminated C strings
+ * The signer handle must be valid and not freed during the call
+ * The returned value MUST be released by calling release_string
+ * and it is no longer valid after that call.
+ */
+IMPORT extern
+char *c2pa_sign_file_with_signer(const char *source_path,
+                                 const char *dest_path,
+                                 const char *manifest,
+                                 const struct C2paSigner *signer,
+                                 const char *data_dir);
+#endif
+
+#if defined(C2PA_SIGNING)
+/**
+ * Re-signs an already signed asset with an updated manifest using a signer
+ * handle, reusing the existing hard binding instead of re-hashing the asset
+ * A metadata only update skips the hashing and ingredient validation passes
+ * over the asset bytes, though the destination file is still rewritten when
+ * the new store is spliced in; the previous manifests are preserved as the
+ * parent of the new claim
+ * The recorded digest is trusted as is; use c2pa_sign_file when the source
+ * asset cannot be trusted
+ *
+ * # Errors
+ * Returns NULL if there were errors, otherwise returns an empty string
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * Reads from null terminated C strings
+ * The signer handle must be valid and not freed during the call
+ * The returned value MUST be released by calling release_string
+ * and it is no longer valid after that call.
+ */
+IMPORT extern
+char *c2pa_resign_file(const char *source_path,
+                       const char *dest_path,
+                       const char *manifest,
+                       const struct C2paSigner *signer,
+                       const char *data_dir);
+#endif
+
+#if defined(C2PA_SIGNING)
+/**
+ * Add a signed manifest to an asset in memory using a signer handle
+ * created by c2pa_signer_create, returning the signed asset
+ * The length of the signed asset is returned via signed_len
+ *
+ * # Errors
+ * Returns NULL if there were errors, otherwise returns the signed asset bytes
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * Reads len bytes from the data pointer, which must remain valid for the call
+ * The signer handle must be valid and not freed during the call
+ * The returned value MUST be released by calling release_buffer
+ * and it is no longer valid after that call.
+ */
+IMPORT extern
+uint8_t *c2pa_sign_buffer_with_signer(const uint8_t *data,
+                                      uintptr_t len,
+                                      const char *format,
+                                      const char *manifest,
+                                      const struct C2paSigner *signer,
+                                      uintptr_t *signed_len);
+#endif
+
+/**
+ * Creates a verification result cache holding up to capacity entries
+ *
+ * Entries are evicted least recently used once capacity is reached
+ *
+ * # Safety
+ * The returned value MUST be released by calling c2pa_reader_cache_free
+ * and it is no longer valid after that call.
+ */
+IMPORT extern struct C2paReaderCache *c2pa_reader_cache_create(uintptr_t capacity);
+
+/**
+ * Returns a ManifestStore JSON string from a file path, consulting the cache
+ *
+ * On a hit the cached report is returned without re-parsing or re-validating
+ * the manifest store; only the file metadata and manifest box are read to
+ * confirm the content identity. No binary resources are written.
+ *
+ * # Errors
+ * Returns NULL if there were errors, otherwise returns a JSON string
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * Reads from null terminated C strings
+ * The returned value MUST be released by calling release_string
+ * and it is no longer valid after that call.
+ */
+IMPORT extern char *c2pa_read_file_cached(const struct C2paReaderCache *cache, const char *path);
+
+/**
+ * Returns the hit and miss counts of a verification result cache
+ *
+ * # Safety
+ * The cache must be a valid handle from c2pa_reader_cache_create
+ * hits and misses are written if non NULL
+ */
+IMPORT extern
+void c2pa_reader_cache_stats(const struct C2paReaderCache *cache,
+                             uint64_t *hits,
+                             uint64_t *misses);
+
+/**
+ * Releases a cache created by c2pa_reader_cache_create
+ *
+ * # Safety
+ * The cache can no longer be used after this call
+ */
+IMPORT extern void c2pa_reader_cache_free(struct C2paReaderCache *cache);
+
+#if defined(C2PA_SIGNING)
+/**
+ * Returns the size in bytes a signer reserves for its signature box
+ *
+ * Pass this to c2pa_manifest_data_hash_placeholder as the reserve_size
+ * when the same signer will sign the manifest
+ *
+ * # Safety
+ * The signer must be a valid handle from c2pa_signer_create
+ */
+IMPORT extern uintptr_t c2pa_signer_reserve_size(const struct C2paSigner *signer);
+#endif
+
+#if defined(C2PA_SIGNING)
+/**
+ * Sets the chunk size in bytes for the data hash read/hash pipeline
+ *
+ * Zero restores the default of 8 MB
+ *
+ * # Safety
+ * May be called from any thread at any time
+ */
+IMPORT extern void c2pa_set_hash_chunk_size(uintptr_t bytes);
+#endif
+
+#if defined(C2PA_SIGNING)
+/**
+ * Sets how many chunks the reader thread may buffer ahead of the hasher
+ * in the data hash pipeline
+ *
+ * Zero restores the default of 4 chunks
+ *
+ * # Safety
+ * May be called from any thread at any time
+ */
+IMPORT extern void c2pa_set_hash_readahead_chunks(uintptr_t chunks);
+#endif
+
+#if defined(C2PA_SIGNING)
+/**
+ * Returns placeholder bytes for a data hashed manifest, pre-formatted for
+ * insertion into an asset of the given format
+ *
+ * The caller writes the placeholder into the output asset, hashes the
+ * result with the placeholder region excluded, and patches in the signed
+ * manifest from c2pa_sign_data_hashed_manifest, which is the same size.
+ * The placeholder length is returned via the len parameter.
+ * reserve_size must be at least the reserve size of the signer that will
+ * sign the manifest.
+ *
+ * # Errors
+ * Returns NULL if there were errors, otherwise returns the placeholder bytes
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * Reads from null terminated C strings
+ * The returned value MUST be released by calling c2pa_release_buffer
+ * and it is no longer valid after that call.
+ */
+IMPORT extern
+uint8_t *c2pa_manifest_data_hash_placeholder(const char *manifest_json,
+                                             uintptr_t reserve_size,
+                                             const char *format,
+                                             uintptr_t *len);
+#endif
+
+#if defined(C2PA_SIGNING)
+/**
+ * Signs a manifest over a caller supplied data hash and returns the signed
+ * manifest bytes, pre-formatted to replace the placeholder in the asset
+ *
+ * data_hash_json holds a DataHash whose exclusions cover the placeholder
+ * region, e.g. {"exclusions": [{"start": 20, "length": 64000}],
+ * "name": "jumbf manifest", "alg": "sha256", "hash": [], "pad": []}
+ * A digest the caller has already computed over the non-excluded ranges
+ * may be supplied in the hash field as a hex string and is used as is, so
+ * the asset is not hashed again. If the hash is empty and asset_path names
+ * the composed asset, the hash is computed here over the non-excluded
+ * ranges with a pipeline that overlaps file reads with hashing (see
+ * c2pa_set_hash_chunk_size). The manifest length is returned via the len
+ * parameter.
+ *
+ * # Errors
+ * Returns NULL if there were errors, otherwise returns the manifest bytes
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * Reads from null terminated C strings
+ * The returned value MUST be released by calling c2pa_release_buffer
+ * and it is no longer valid after that call.
+ */
+IMPORT extern
+uint8_t *c2pa_sign_data_hashed_manifest(const char *manifest_json,
+                                        const struct C2paSigner *signer,
+                                        const char *format,
+                                        const char *data_hash_json,
+                                        const char *asset_path,
+                                        uintptr_t *len);
+#endif
+
+#if defined(C2PA_SIGNING)
+/**
+ * Signs a manifest for the file at source_path without rewriting the asset
+ * and returns the signed manifest store bytes
+ *
+ * The asset is only read, to hash its bytes, so signing a large master does
+ * not copy it. With a NULL remote_url the manifest is written as a detached
+ * .c2pa sidecar, to sidecar_path or next to the asset when sidecar_path is
+ * NULL, where readers find it when the asset has no embedded manifest.
+ * With a remote_url the claim records that url as the manifest location and
+ * the returned bytes are for the caller to host there; a sidecar is then
+ * only written if sidecar_path is also given. The manifest length is
+ * returned via the len parameter.
+ *
+ * # Errors
+ * Returns NULL if there were errors, otherwise returns the manifest bytes
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * Reads from null terminated C strings
+ * The signer handle must be valid and not freed during the call
+ * The returned value MUST be released by calling c2pa_release_buffer
+ * and it is no longer valid after that call.
+ */
+IMPORT extern
+uint8_t *c2pa_sign_file_detached(const char *source_path,
+                                 const char *manifest,
+                                 const struct C2paSigner *signer,
+                                 const char *sidecar_path,
+                                 const char *remote_url,
+                                 uintptr_t *len);
+#endif
+
+#if defined(C2PA_SIGNING)
+/**
+ * Frees a signer handle created by c2pa_signer_create
+ *
+ * # Safety
+ * The handle can only be freed once and is invalid after this call
+ */
+IMPORT extern void c2pa_signer_free(struct C2paSigner *signer);
+#endif
+
+#if defined(C2PA_SIGNING)
+/**
+ * Creates a signing session from the signer_info fields
+ *
+ * Each worker thread parses its own signer when the session is created, so
+ * the key and certificate chain are warm before the first request. Queued
+ * requests go to whichever worker frees up first, so hashing, signing and
+ * timestamp authority round trips for different assets overlap.
+ * thread_count of 0 uses the available parallelism of the host
+ *
+ * # Errors
+ * Returns NULL if there were errors, otherwise returns a session handle
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * Reads from null terminated C strings
+ * The returned value MUST be released by calling c2pa_signer_session_free
+ * and it is no longer valid after that call.
+ */
+IMPORT extern
+struct C2paSignerSession *c2pa_signer_session_create(const struct C2paSignerInfo *signer_info,
+                                                     uintptr_t thread_count);
+#endif
+
+#if defined(C2PA_SIGNING)
+/**
+ * Queues a file to sign on the session and returns immediately
+ *
+ * The callback, if not NULL, is called once from a worker thread when the
+ * request completes, with the error message or NULL on success
+ *
+ * # Errors
+ * Returns -1 if the request could not be queued, otherwise 0; per request
+ * errors are reported through the callback
+ *
+ * # Safety
+ * Reads from null terminated C strings
+ * The session must be a valid handle from c2pa_signer_session_create
+ * The callback may be invoked from another thread and must be thread safe;
+ * its error pointer is only valid during the callback
+ * The context must remain valid until the callback has run
+ */
+IMPORT extern
+int c2pa_signer_session_sign_file(const struct C2paSignerSession *session,
+                                  const char *source_path,
+                                  const char *dest_path,
+                                  const char *manifest,
+                                  void (*callback)(const char *error, void *context),
+                                  void *context);
+#endif
+
+#if defined(C2PA_SIGNING)
+/**
+ * Blocks until every queued request on the session has completed
+ *
+ * Returns the number of files signed successfully since the session was
+ * created
+ *
+ * # Safety
+ * The session must be a valid handle from c2pa_signer_session_create
+ */
+IMPORT extern int64_t c2pa_signer_session_wait(const struct C2paSignerSession *session);
+#endif
+
+#if defined(C2PA_SIGNING)
+/**
+ * Frees a session handle created by c2pa_signer_session_create
+ *
+ * Waits for any queued requests to drain before returning
+ *
+ * # Safety
+ * The handle can only be freed once and is invalid after this call
+ */
+IMPORT extern void c2pa_signer_session_free(struct C2paSignerSession *session);
+#endif
+
+#if defined(C2PA_SIGNING)
+/**
+ * Add a signed manifest to the file at path using auth_token
+ * If cloud is true, upload the manifest to the cloud
+ *
+ * # Errors
+ * Returns an error field if there were errors
+ *
+ * # Safety
+ * Reads from null terminated C strings
+ * The returned value MUST be released by calling release_string
+ * and it is no longer valid after that call.
+ */
+IMPORT extern
+char *c2pa_sign_file(const char *source_path,
+                     const char *dest_path,
+                     const char *manifest,
+                     const struct C2paSignerInfo *signer_info,
+                     const char *data_dir);
+#endif
+
+#if defined(C2PA_SIGNING)
+/**
+ * Add a signed manifest to an asset in memory and return the signed asset
+ * The format must be a supported mime type or extension (e.g. "image/jpeg" or "jpg")
+ * The length of the signed asset is returned via signed_len
+ *
+ * # Errors
+ * Returns NULL if there were errors, otherwise returns the signed asset bytes
+ * The error string can be retrieved by calling c2pa_error
+ *
+ * # Safety
+ * Reads len bytes from the data pointer, which must remain valid for the call
+ * The returned value MUST be released by calling release_buffer
+ * and it is no longer valid after that call.
+ */
+IMPORT extern
+uint8_t *c2pa_sign_buffer(const uint8_t *data,
+                          uintptr_t len,
+                          const char *format,
+                          const char *manifest,
+                          const struct C2paSignerInfo *signer_info,
+                          uintptr_t *signed_len);
+#endif
+
+/**
+ * Reads a batch of files over an internal worker pool
+ *
+ * Workers pull paths from a shared queue so fast and slow assets balance
+ * across the pool, keeping I/O and validation running on all cores from a
+ * single process. No binary resources are written.
+ *
+ * thread_count of 0 uses the available parallelism of the host.
+ * The callback is called once per item, from a worker thread, with the item
+ * index and either the ManifestStore JSON or the error message for that
+ * item; exactly one of the two is non NULL. Both pointers are only valid
+ * for the duration of the call. The callback and context must be safe to
+ * use from multiple threads at once.
+ *
+ * # Errors
+ * Returns the number of files read successfully, or -1 if the batch could
+ * not be started. Per item errors are reported through the callback.
+ *
+ * # Safety
+ * Reads count pointers from paths, each a null terminated C string
+ */
+IMPORT extern
+int64_t c2pa_read_files(const char *const *paths,
+                        uintptr_t count,
+                        uintptr_t thread_count,
+                        void (*callback)(uintptr_t index,
+                                         const char *json,
+                                         const char *error,
+                                         void *context),
+                        void *context);
+
+#if defined(C2PA_SIGNING)
+/**
+ * Sign a batch of files over an internal worker pool using one manifest and signer_info
+ * source_paths and dest_paths are parallel arrays of count paths
+ * thread_count of 0 uses all available cores
+ * The callback, if not NULL, is called once per item from a worker thread
+ * with the item index, an error message or NULL on success, and the context;
+ * it must be thread safe and the error pointer is only valid during the callback
+ *
+ * # Errors
+ * Returns -1 if the batch could not be started; per-item errors are reported
+ * through the callback since worker errors cannot reach this thread's c2pa_error
+ *
+ * # Safety
+ * Reads from arrays of null terminated C strings, which must hold count entries
+ * The context must remain valid until this call returns
+ */
+IMPORT extern
+int64_t c2pa_sign_files_batch(const char *const *source_paths,
+                              const char *const *dest_paths,
+                              uintptr_t count,
+                              const char *manifest,
+                              const struct C2paSignerInfo *signer_info,
+                              uintptr_t thread_count,
+                              void (*callback)(uintptr_t index, const char *error, void *context),
+                              void *context);
+#endif
+
+/**
+ * Releases a string allocated by Rust
+ *
+ * # Safety
+ * Reads from null terminated C strings
+ * The string must not have been modified in C
+ * can only be released once and is invalid after this call
+ */
+IMPORT extern void c2pa_release_string(char *s);
+
+/**
+ * Releases a buffer allocated by Rust
+ *
+ * # Safety
+ * The buffer must have been allocated by this library with the given length
+ * can only be released once and is invalid after this call
+ */
+IMPORT extern void c2pa_release_buffer(uint8_t *buf, uintptr_t len);
+
+/**
+ * Creates a new C2paStream from context with callbacks
+ *
+ * This allows implementing streams in other languages
+ *
+ * # Arguments
+ * * `context` - a pointer to a StreamContext
+ * * `reader` - a ReadCallback to read from the stream
+ * * `seeker` - a SeekCallback to seek in the stream
+ * * `writer` - a WriteCallback to write to the stream
+ * * `flusher` - a FlushCallback to flush the stream
+ *
+ * # Safety
+ * The context must remain valid for the lifetime of the C2paStream
+ * The returned value MUST be released by calling c2pa_release_stream
+ * and it is no longer valid after that call.
+ */
+IMPORT extern
+struct C2paStream *c2pa_create_stream(struct StreamContext *context,
+                                      ReadCallback reader,
+                                      SeekCallback seeker,
+                                      WriteCallback writer,
+                                      FlushCallback flusher);
+
+/**
+ * Releases a C2paStream allocated by Rust
+ *
+ * # Safety
+ * can only be released once and is invalid after this call
+ */
+IMPORT extern void c2pa_release_stream(struct C2paStream *stream);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
 
-#endif /* c2pa_bindings_h */
+#endif  /* c2pa_bindings_h */
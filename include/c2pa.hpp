@@ -15,22 +15,28 @@
 #include "c2pa.h"
 #include <optional>  // C++17
 #include <filesystem> // C++17
+#include <string_view> // C++17
+#include <vector>
 using path = std::filesystem::path;
 
 namespace C2pa
 {
     using namespace std;
 
+#if defined(C2PA_SIGNING)
     typedef C2paSignerInfo SignerInfo;
+#endif
 
     // Exception class for C2pa errors
     class Exception : public exception
     {
     private:
         string message;
+        C2paErrorCode error_code;
 
     public:
-        Exception() : message(c2pa_error()) {
+        Exception() : error_code(c2pa_error_code())
+        {
             auto result = c2pa_error();
             message = string(result);
             c2pa_release_string(result);
@@ -40,58 +46,232 @@ namespace C2pa
         {
             return message.c_str();
         }
+
+        // Return the numeric code of the error (see C2paErrorCode in c2pa.h)
+        C2paErrorCode code() const
+        {
+            return error_code;
+        }
+    };
+
+    // An owned result string from the C2pa library
+    // Keeps the Rust allocated buffer without copying it into a std::string
+    // and releases it via c2pa_release_string when it goes out of scope
+    class String
+    {
+    private:
+        char *value;
+
+    public:
+        // Takes ownership of a string allocated by the C2pa library
+        explicit String(char *result) : value(result) {}
+
+        ~String()
+        {
+            c2pa_release_string(value);
+        }
+
+        // Strings own the Rust buffer and cannot be copied, only moved
+        String(const String &) = delete;
+        String &operator=(const String &) = delete;
+
+        String(String &&other) noexcept : value(other.value)
+        {
+            other.value = NULL;
+        }
+
+        String &operator=(String &&other) noexcept
+        {
+            if (this != &other)
+            {
+                c2pa_release_string(value);
+                value = other.value;
+                other.value = NULL;
+            }
+            return *this;
+        }
+
+        // Return a view of the string without copying
+        std::string_view view() const
+        {
+            return value ? std::string_view(value) : std::string_view();
+        }
+
+        operator std::string_view() const
+        {
+            return view();
+        }
+
+        const char *c_str() const
+        {
+            return value ? value : "";
+        }
+
+        size_t size() const
+        {
+            return view().size();
+        }
+
+        // Return an owned copy as a std::string
+        string str() const
+        {
+            return string(view());
+        }
+
+        friend std::ostream &operator<<(std::ostream &os, const String &s)
+        {
+            return os << s.view();
+        }
     };
 
     // Return the version of the C2pa library
-    string version()
+    String version()
     {
-        auto result = c2pa_version();
-        string str = string(result);
-        c2pa_release_string(result);
-        return str;
+        return String(c2pa_version());
     }
 
     // Read a file and return the manifest json as a C2pa::String
     // Note: Paths are UTF-8 encoded, use std.filename.u8string().c_str() if needed
     // source_path: path to the file to read
     // data_dir: the directory to store binary resources (optional)
-    // Returns a string containing the manifest json if a manifest was found
+    // Returns a C2pa::String owning the manifest json if a manifest was found
     // Throws a C2pa::Exception for errors encountered by the C2pa library
-    std::optional<string> read_file(const std::filesystem::path& source_path, const std::optional<path> data_dir = std::nullopt)
+    // flags: optional combination of C2PA_READ_SKIP_RESOURCES and C2PA_READ_SKIP_THUMBNAILS
+    std::optional<String> read_file(const std::filesystem::path& source_path, const std::optional<path> data_dir = std::nullopt, uint32_t flags = 0)
     {
         const char* dir = data_dir.has_value() ? data_dir.value().c_str() : NULL;
-        char *result = c2pa_read_file(source_path.c_str(), dir);
+        char *result = c2pa_read_file_with_flags(source_path.c_str(), dir, flags);
         if (result == NULL)
-        {   
-            auto exception = Exception();
-            if (strstr(exception.what(), "ManifestNotFound") != NULL)
+        {
+            if (c2pa_error_code() == C2paErrorManifestNotFound)
             {
                 return std::nullopt;
             }
             throw Exception();
         }
-        string str = string(result);
-        c2pa_release_string(result);
-        return str;
+        return String(result);
+    }
+
+    // Read a file and return the manifest store report as CBOR bytes
+    // This skips the JSON text round trip; the report mirrors the
+    // structure of the json returned by read_file
+    // source_path: path to the file to read
+    // Returns a vector of CBOR bytes if a manifest was found
+    // Throws a C2pa::Exception for errors encountered by the C2pa library
+    std::optional<std::vector<uint8_t>> read_file_cbor(const path& source_path)
+    {
+        size_t len = 0;
+        uint8_t *result = c2pa_read_file_cbor(source_path.c_str(), &len);
+        if (result == NULL)
+        {
+            if (c2pa_error_code() == C2paErrorManifestNotFound)
+            {
+                return std::nullopt;
+            }
+            throw Exception();
+        }
+        std::vector<uint8_t> cbor(result, result + len);
+        c2pa_release_buffer(result, len);
+        return cbor;
+    }
+
+    // Return true if the file contains a C2PA manifest store
+    // This only scans container headers and is much cheaper than read_file
+    // for assets with no C2PA data
+    // source_path: path to the file to check
+    // Throws a C2pa::Exception for errors encountered by the C2pa library
+    bool has_manifest(const path& source_path)
+    {
+        int result = c2pa_has_manifest(source_path.c_str());
+        if (result < 0)
+        {
+            throw Exception();
+        }
+        return result == 1;
+    }
+
+    // Read only the selected fields of the active manifest from a file
+    // source_path: path to the file to read
+    // labels: comma separated assertion labels and/or "title",
+    //         "claim_generator", "validation_status"
+    // Returns a JSON object holding the requested values if a manifest was found
+    // Throws a C2pa::Exception for errors encountered by the C2pa library
+    std::optional<String> read_file_selected(const path& source_path, const string& labels)
+    {
+        char *result = c2pa_read_file_selected(source_path.c_str(), labels.c_str());
+        if (result == NULL)
+        {
+            if (c2pa_error_code() == C2paErrorManifestNotFound)
+            {
+                return std::nullopt;
+            }
+            throw Exception();
+        }
+        return String(result);
+    }
+
+    // Read an asset held in memory and return the manifest json
+    // data: pointer to the asset bytes
+    // len: length of the asset in bytes
+    // format: the mime type or extension of the asset (for example "image/jpeg")
+    // Returns a C2pa::String owning the manifest json if a manifest was found
+    // Throws a C2pa::Exception for errors encountered by the C2pa library
+    std::optional<String> read_buffer(const uint8_t *data, size_t len, const string& format)
+    {
+        char *result = c2pa_read_buffer(data, len, format.c_str());
+        if (result == NULL)
+        {
+            if (c2pa_error_code() == C2paErrorManifestNotFound)
+            {
+                return std::nullopt;
+            }
+            throw Exception();
+        }
+        return String(result);
+    }
+
+    // Read a fragmented BMFF asset held in memory and return the manifest json
+    // e.g. one DASH/HLS media segment plus its init segment
+    // init_data/init_len: the init segment bytes
+    // fragment_data/fragment_len: the media segment bytes
+    // format: the mime type or extension of the asset (for example "video/mp4")
+    // Returns a C2pa::String owning the manifest json if a manifest was found
+    // Throws a C2pa::Exception for errors encountered by the C2pa library
+    std::optional<String> read_fragment(const uint8_t *init_data, size_t init_len,
+                                        const uint8_t *fragment_data, size_t fragment_len,
+                                        const string& format)
+    {
+        char *result = c2pa_read_fragment(init_data, init_len, fragment_data, fragment_len, format.c_str());
+        if (result == NULL)
+        {
+            if (c2pa_error_code() == C2paErrorManifestNotFound)
+            {
+                return std::nullopt;
+            }
+            throw Exception();
+        }
+        return String(result);
     }
 
     // Read a file and return an ingredient json as a C2pa::String
     // source_path: path to the file to read
     // data_dir: the directory to store binary resources
-    // Returns a string containing the manifest json
+    // Returns a C2pa::String owning the ingredient json
     // Throws a C2pa::Exception for errors encountered by the C2pa library
-    string read_ingredient_file(const path& source_path, const path& data_dir)
+    // flags: optional combination of C2PA_READ_SKIP_RESOURCES and C2PA_READ_SKIP_THUMBNAILS
+    String read_ingredient_file(const path& source_path, const path& data_dir, uint32_t flags = 0)
     {
-        char *result = c2pa_read_ingredient_file(source_path.c_str(), data_dir.c_str());
+        char *result = c2pa_read_ingredient_file_with_flags(source_path.c_str(), data_dir.c_str(), flags);
         if (result == NULL)
         {
             throw Exception();
         }
-        string str = string(result);
-        c2pa_release_string(result);
-        return str;
+        return String(result);
     }
 
+// The signing wrappers need a library built with the signing feature;
+// they are hidden when C2PA_VERIFY_ONLY is defined (see c2pa.h)
+#if defined(C2PA_SIGNING)
     // Add the manifest and sign a file
     // source_path: path to the asset to be signed
     // dest_path: the path to write the signed file to
@@ -115,4 +295,268 @@ namespace C2pa
         c2pa_release_string(result);
         return;
     }
+
+    // Add the manifest and sign an asset held in memory
+    // data: pointer to the asset bytes
+    // len: length of the asset in bytes
+    // format: the mime type or extension of the asset (for example "image/jpeg")
+    // manifest: the manifest json to add to the asset
+    // signer_info: the signer info to use for signing
+    // Returns a vector containing the signed asset bytes
+    // Throws a C2pa::Exception for errors encountered by the C2pa library
+    std::vector<uint8_t> sign_buffer(const uint8_t *data,
+                                     size_t len,
+                                     const string& format,
+                                     const char *manifest,
+                                     SignerInfo *signer_info)
+    {
+        size_t signed_len = 0;
+        uint8_t *result = c2pa_sign_buffer(data, len, format.c_str(), manifest, signer_info, &signed_len);
+        if (result == NULL)
+        {
+            throw Exception();
+        }
+        std::vector<uint8_t> signed_data(result, result + signed_len);
+        c2pa_release_buffer(result, signed_len);
+        return signed_data;
+    }
+
+    // Return placeholder bytes for a data hashed manifest, pre-formatted for
+    // insertion into an asset of the given format (see
+    // c2pa_manifest_data_hash_placeholder in c2pa.h for the full flow)
+    // manifest_json: the manifest json to reserve space for
+    // reserve_size: at least the reserve_size() of the signer that will sign
+    // format: the mime type or extension of the asset (for example "image/jpeg")
+    // Throws a C2pa::Exception for errors encountered by the C2pa library
+    std::vector<uint8_t> manifest_data_hash_placeholder(const char *manifest_json,
+                                                        size_t reserve_size,
+                                                        const string& format)
+    {
+        size_t len = 0;
+        uint8_t *result = c2pa_manifest_data_hash_placeholder(manifest_json, reserve_size, format.c_str(), &len);
+        if (result == NULL)
+        {
+            throw Exception();
+        }
+        std::vector<uint8_t> placeholder(result, result + len);
+        c2pa_release_buffer(result, len);
+        return placeholder;
+    }
+#endif // C2PA_SIGNING
+
+    // Applies process wide library settings for the lifetime of the instance
+    // and restores the built-in defaults when it goes out of scope
+    // See c2pa_settings_set in c2pa.h for the known keys
+    // Throws a C2pa::Exception for errors encountered by the C2pa library
+    class Settings
+    {
+    public:
+        Settings() = default;
+
+        // json: a flat JSON object of settings, e.g.
+        // {"hash_chunk_size": 4194304, "mmap_read": true}
+        // The object is validated before anything is applied
+        Settings(const char *json)
+        {
+            if (c2pa_settings_load(json) != 0)
+            {
+                throw Exception();
+            }
+        }
+
+        // Applies one named setting
+        void set(const char *key, uint64_t value)
+        {
+            if (c2pa_settings_set(key, value) != 0)
+            {
+                throw Exception();
+            }
+        }
+
+        ~Settings()
+        {
+            c2pa_settings_reset();
+        }
+    };
+
+#if defined(C2PA_SIGNING)
+    // A reusable signer that parses the certificates and private key once
+    // and can then sign any number of assets
+    // Throws a C2pa::Exception for errors encountered by the C2pa library
+    class Signer
+    {
+    private:
+        C2paSigner *signer;
+
+    public:
+        Signer(SignerInfo *signer_info)
+        {
+            signer = c2pa_signer_create(signer_info);
+            if (signer == NULL)
+            {
+                throw Exception();
+            }
+        }
+
+        ~Signer()
+        {
+            c2pa_signer_free(signer);
+        }
+
+        // Signers own a Rust handle and cannot be copied
+        Signer(const Signer &) = delete;
+        Signer &operator=(const Signer &) = delete;
+
+        // Add the manifest and sign a file (see C2pa::sign_file)
+        void sign_file(const path& source_path,
+                       const path& dest_path,
+                       const char *manifest,
+                       const std::optional<path> data_dir = std::nullopt)
+        {
+            const char* dir = data_dir.has_value() ? data_dir.value().c_str() : NULL;
+            char *result = c2pa_sign_file_with_signer(source_path.c_str(), dest_path.c_str(), manifest, signer, dir);
+            if (result == NULL)
+            {
+                throw Exception();
+            }
+            c2pa_release_string(result);
+        }
+
+        // Re-sign an already signed file with an updated manifest, reusing
+        // the existing hard binding instead of re-hashing the asset; the
+        // previous manifests are preserved as the parent of the new claim
+        // Throws a C2pa::Exception for errors encountered by the C2pa library
+        void resign_file(const path& source_path,
+                         const path& dest_path,
+                         const char *manifest,
+                         const std::optional<path> data_dir = std::nullopt)
+        {
+            const char* dir = data_dir.has_value() ? data_dir.value().c_str() : NULL;
+            char *result = c2pa_resign_file(source_path.c_str(), dest_path.c_str(), manifest, signer, dir);
+            if (result == NULL)
+            {
+                throw Exception();
+            }
+            c2pa_release_string(result);
+        }
+
+        // Return the size in bytes this signer reserves for its signature box
+        size_t reserve_size()
+        {
+            return c2pa_signer_reserve_size(signer);
+        }
+
+        // Sign a manifest over a caller supplied data hash and return the
+        // signed manifest bytes, pre-formatted to replace the placeholder
+        // data_hash_json: a DataHash whose exclusions cover the placeholder
+        //     region; a digest the caller already computed may be supplied
+        //     in the hash field as a hex string and is then used as is
+        // asset_path: the composed asset to hash when no digest is supplied
+        // Throws a C2pa::Exception for errors encountered by the C2pa library
+        std::vector<uint8_t> sign_data_hashed_manifest(const char *manifest_json,
+                                                       const string& format,
+                                                       const string& data_hash_json,
+                                                       const std::optional<path> asset_path = std::nullopt)
+        {
+            const char* asset = asset_path.has_value() ? asset_path.value().c_str() : NULL;
+            size_t len = 0;
+            uint8_t *result = c2pa_sign_data_hashed_manifest(manifest_json, signer, format.c_str(), data_hash_json.c_str(), asset, &len);
+            if (result == NULL)
+            {
+                throw Exception();
+            }
+            std::vector<uint8_t> signed_manifest(result, result + len);
+            c2pa_release_buffer(result, len);
+            return signed_manifest;
+        }
+
+        // Sign a manifest for the file at source_path without rewriting the
+        // asset and return the signed manifest store bytes
+        // With no remote_url a detached .c2pa sidecar is written, to
+        // sidecar_path or next to the asset; with a remote_url the claim
+        // records that url and a sidecar is only written if sidecar_path
+        // is also given
+        // Throws a C2pa::Exception for errors encountered by the C2pa library
+        std::vector<uint8_t> sign_file_detached(const path& source_path,
+                                                const char *manifest,
+                                                const std::optional<path> sidecar_path = std::nullopt,
+                                                const std::optional<string> remote_url = std::nullopt)
+        {
+            const char* sidecar = sidecar_path.has_value() ? sidecar_path.value().c_str() : NULL;
+            const char* url = remote_url.has_value() ? remote_url.value().c_str() : NULL;
+            size_t len = 0;
+            uint8_t *result = c2pa_sign_file_detached(source_path.c_str(), manifest, signer, sidecar, url, &len);
+            if (result == NULL)
+            {
+                throw Exception();
+            }
+            std::vector<uint8_t> manifest_bytes(result, result + len);
+            c2pa_release_buffer(result, len);
+            return manifest_bytes;
+        }
+
+        // Add the manifest and sign an asset held in memory (see C2pa::sign_buffer)
+        std::vector<uint8_t> sign_buffer(const uint8_t *data,
+                                         size_t len,
+                                         const string& format,
+                                         const char *manifest)
+        {
+            size_t signed_len = 0;
+            uint8_t *result = c2pa_sign_buffer_with_signer(data, len, format.c_str(), manifest, signer, &signed_len);
+            if (result == NULL)
+            {
+                throw Exception();
+            }
+            std::vector<uint8_t> signed_data(result, result + signed_len);
+            c2pa_release_buffer(result, signed_len);
+            return signed_data;
+        }
+    };
+
+    // A long lived signing session over an internal worker pool
+    // Each worker parses its own signer when the session is created, so the
+    // key and certificate chain are warm before the first request and
+    // concurrent requests overlap their hashing, signing and timestamp
+    // authority round trips
+    // Throws a C2pa::Exception for errors encountered by the C2pa library
+    class SignerSession
+    {
+    private:
+        C2paSignerSession *session;
+
+    public:
+        // thread_count of 0 uses the available parallelism of the host
+        SignerSession(SignerInfo *signer_info, size_t thread_count = 0)
+        {
+            session = c2pa_signer_session_create(signer_info, thread_count);
+            if (session == NULL)
+            {
+                throw Exception();
+            }
+        }
+
+        ~SignerSession()
+        {
+            c2pa_signer_session_free(session);
+        }
+
+        // Queues a file to sign and returns immediately; failures are
+        // reported by the count returned from wait()
+        // Note: Paths are UTF-8 encoded, use std.filename.u8string().c_str() if needed
+        void sign_file(const path& source_path, const path& dest_path, const char *manifest)
+        {
+            if (c2pa_signer_session_sign_file(session, source_path.c_str(), dest_path.c_str(), manifest, NULL, NULL) != 0)
+            {
+                throw Exception();
+            }
+        }
+
+        // Blocks until every queued request has completed and returns the
+        // number signed successfully since the session was created
+        size_t wait()
+        {
+            return (size_t)c2pa_signer_session_wait(session);
+        }
+    };
+#endif // C2PA_SIGNING
 }
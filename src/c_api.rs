@@ -13,13 +13,31 @@
 
 use std::{
     ffi::{CStr, CString},
-    os::raw::c_char,
+    os::raw::{c_char, c_void},
 };
 
 use crate::{
-    error::Error,
-    json_api::{read_file, read_ingredient_file, sign_file},
-    signer_info::SignerInfo,
+    c_stream::C2paStream,
+    error::{C2paErrorCode, Error},
+    json_api::{
+        has_manifest, read_buffer, read_file, read_file_cached, read_file_cbor, read_file_selected,
+        read_file_stream, read_file_with_flags, read_files, read_fragment, read_ingredient_file,
+        read_ingredient_file_cbor, read_ingredient_file_with_flags,
+        read_ingredient_file_with_options, read_ingredient_stream, read_stream, set_mmap_read,
+        IngredientExtractOptions, ReaderCache,
+    },
+    trace::{set_trace_callback, C2paTraceStage},
+};
+#[cfg(feature = "signing")]
+use crate::{
+    json_api::{
+        compile_manifest, data_hash_placeholder, resign_file, set_hash_chunk_size,
+        set_hash_readahead_chunks, sign_buffer, sign_buffer_with_signer, sign_data_hashed_manifest,
+        sign_file, sign_file_detached, sign_file_with_options, sign_file_with_signer,
+        sign_file_with_template, sign_files_batch, sign_stream, ManifestTemplate, OnSignComplete,
+        SignerSession,
+    },
+    signer_info::{set_timestamp_cache_ttl, SignerInfo},
 };
 
 // Internal routine to convert a *const c_char to a rust String
@@ -39,6 +57,19 @@ macro_rules! from_cstr_null_check {
     };
 }
 
+// Internal routine to convert a *const c_char to a rust String or return -1,
+// for calls that report sizes rather than pointers
+macro_rules! from_cstr_size_check {
+    ($ptr : expr) => {
+        if $ptr.is_null() {
+            Error::set_last(Error::NullParameter(stringify!($ptr).to_string()));
+            return -1;
+        } else {
+            from_c_str($ptr)
+        }
+    };
+}
+
 // Internal routine to convert a *const c_char to Option<String>
 macro_rules! from_cstr_option {
     ($ptr : expr) => {
@@ -50,6 +81,31 @@ macro_rules! from_cstr_option {
     };
 }
 
+// Internal routine to return a rust Vec<u8> to C as *mut u8
+// The length is returned via the len parameter
+// The returned value MUST be released by calling release_buffer
+// and it is no longer valid after that call.
+unsafe fn to_c_buffer(data: Vec<u8>, len: *mut usize) -> *mut u8 {
+    let boxed = data.into_boxed_slice();
+    if !len.is_null() {
+        *len = boxed.len();
+    }
+    Box::into_raw(boxed) as *mut u8
+}
+
+// Internal routine to copy a rust String into a caller provided buffer
+// Returns the required buffer size in bytes including the null terminator;
+// the string is only written (null terminated) when the buffer is large enough
+unsafe fn string_into_buffer(s: String, buf: *mut c_char, buf_len: usize) -> i64 {
+    let bytes = s.as_bytes();
+    let required = bytes.len() + 1;
+    if !buf.is_null() && buf_len >= required {
+        std::ptr::copy_nonoverlapping(bytes.as_ptr(), buf as *mut u8, bytes.len());
+        *buf.add(bytes.len()) = 0;
+    }
+    required as i64
+}
+
 // Internal routine to return a rust String reference to C as *mut c_char
 // The returned value MUST be released by calling release_string
 // and it is no longer valid after that call.
@@ -87,6 +143,107 @@ pub unsafe extern "C" fn c2pa_error() -> *mut c_char {
     to_c_string(Error::last_message().unwrap_or_default())
 }
 
+/// Returns the numeric code of the last error
+///
+/// Unlike c2pa_error this performs no formatting or allocation, so hot
+/// paths can classify common failures such as C2paErrorManifestNotFound
+/// without string matching. Returns C2paErrorNone if no error has occurred.
+///
+/// # Safety
+/// May be called from any thread; the last error is thread local
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_error_code() -> C2paErrorCode {
+    Error::last_code()
+}
+
+/// Writes the last error message into a caller buffer
+///
+/// Unlike c2pa_error nothing needs to be released; an empty string is
+/// written if no error has occurred
+///
+/// # Errors
+/// Returns the required buffer size in bytes including the null terminator
+///
+/// # Safety
+/// Writes at most buf_len bytes to buf, which may be NULL to query the size
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_error_into(buf: *mut c_char, buf_len: usize) -> i64 {
+    string_into_buffer(Error::last_message().unwrap_or_default(), buf, buf_len)
+}
+
+/// Enables or disables memory mapped reads for the file based read paths
+///
+/// While enabled, c2pa_read_file and the other file based readers map the
+/// asset into memory and parse it in place instead of copying it through
+/// buffered reads; off by default
+///
+/// # Safety
+/// May be called from any thread at any time
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_set_mmap_read(enabled: bool) {
+    set_mmap_read(enabled);
+}
+
+/// Applies one named library setting
+///
+/// Known keys are "mmap_read", "hash_chunk_size", "hash_readahead_chunks"
+/// and "timestamp_cache_ttl"; the last three exist only when the library is
+/// built with signing support
+///
+/// # Errors
+/// Returns -1 for an unknown key, otherwise 0
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// Reads from a null terminated C string
+/// May be called from any thread at any time
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_settings_set(key: *const c_char, value: u64) -> std::os::raw::c_int {
+    let key = from_cstr_size_check!(key);
+    match crate::settings_set(&key, value) {
+        Ok(()) => 0,
+        Err(e) => {
+            e.set_last();
+            -1
+        }
+    }
+}
+
+/// Applies a flat JSON object of settings, e.g.
+/// {"hash_chunk_size": 4194304, "mmap_read": true}
+///
+/// Values must be unsigned integers or booleans. The whole object is
+/// validated before anything is applied, so a rejected load leaves every
+/// setting unchanged
+///
+/// # Errors
+/// Returns -1 for invalid JSON, an unknown key or a bad value, otherwise 0
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// Reads from a null terminated C string
+/// May be called from any thread at any time
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_settings_load(json: *const c_char) -> std::os::raw::c_int {
+    let json = from_cstr_size_check!(json);
+    match crate::settings_load_json(&json) {
+        Ok(()) => 0,
+        Err(e) => {
+            e.set_last();
+            -1
+        }
+    }
+}
+
+/// Restores every library setting to its built-in default
+///
+/// # Safety
+/// May be called from any thread at any time
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_settings_reset() {
+    crate::settings_reset();
+}
+
 /// Returns a ManifestStore JSON string from a file path.
 /// Any thumbnails or other binary resources will be written to data_dir if provided
 ///
@@ -117,12 +274,131 @@ pub unsafe extern "C" fn c2pa_read_file(
     }
 }
 
-/// Returns an Ingredient JSON string from a file path.
-/// Any thumbnail or c2pa data will be written to data_dir if provided
+/// Writes a ManifestStore JSON string from a file path into a caller buffer
+/// Any thumbnails or other binary resources will be written to data_dir if provided
+///
+/// Unlike c2pa_read_file no Rust allocation is handed to the caller, so a
+/// pooled buffer can be reused across calls and nothing needs to be released.
+/// The json is only written, null terminated, when the buffer is large
+/// enough; on a larger return value grow the buffer and call again.
+///
+/// # Errors
+/// Returns the required buffer size in bytes including the null terminator,
+/// or -1 if there were errors
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// Reads from null terminated C strings
+/// Writes at most buf_len bytes to buf, which may be NULL to query the size
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_read_file_into(
+    path: *const c_char,
+    data_dir: *const c_char,
+    buf: *mut c_char,
+    buf_len: usize,
+) -> i64 {
+    let path = from_cstr_size_check!(path);
+    let data_dir = from_cstr_option!(data_dir);
+
+    let result = read_file(&path, data_dir);
+
+    match result {
+        Ok(json) => string_into_buffer(json, buf, buf_len),
+        Err(e) => {
+            e.set_last();
+            -1
+        }
+    }
+}
+
+/// Returns a ManifestStore JSON string from an asset in memory.
+/// The format must be a supported mime type or extension (e.g. "image/jpeg" or "jpg")
+///
+/// # Errors
+/// Returns NULL if there were errors, otherwise returns a JSON string
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// Reads len bytes from the data pointer, which must remain valid for the call
+/// The returned value MUST be released by calling release_string
+/// and it is no longer valid after that call.
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_read_buffer(
+    data: *const u8,
+    len: usize,
+    format: *const c_char,
+) -> *mut c_char {
+    if data.is_null() {
+        Error::set_last(Error::NullParameter("data".to_string()));
+        return std::ptr::null_mut();
+    }
+    let format = from_cstr_null_check!(format);
+    let data = std::slice::from_raw_parts(data, len);
+
+    let result = read_buffer(&format, data);
+
+    match result {
+        Ok(json) => to_c_string(json),
+        Err(e) => {
+            e.set_last();
+            std::ptr::null_mut()
+        }
+    }
+}
+
+/// Returns a ManifestStore JSON string from a fragmented BMFF asset held in
+/// memory, e.g. one DASH/HLS media segment plus its init segment
+/// Only the two segments are read, so a player can validate fragments as
+/// they arrive instead of concatenating the stream into a monolithic file
+/// The format must be a supported BMFF mime type or extension (e.g.
+/// "video/mp4" or "mp4")
+///
+/// # Errors
+/// Returns NULL if there were errors, otherwise returns a JSON string
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// Reads init_len and fragment_len bytes from the init_data and
+/// fragment_data pointers, which must remain valid for the call
+/// The returned value MUST be released by calling release_string
+/// and it is no longer valid after that call.
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_read_fragment(
+    init_data: *const u8,
+    init_len: usize,
+    fragment_data: *const u8,
+    fragment_len: usize,
+    format: *const c_char,
+) -> *mut c_char {
+    if init_data.is_null() {
+        Error::set_last(Error::NullParameter("init_data".to_string()));
+        return std::ptr::null_mut();
+    }
+    if fragment_data.is_null() {
+        Error::set_last(Error::NullParameter("fragment_data".to_string()));
+        return std::ptr::null_mut();
+    }
+    let format = from_cstr_null_check!(format);
+    let init_data = std::slice::from_raw_parts(init_data, init_len);
+    let fragment_data = std::slice::from_raw_parts(fragment_data, fragment_len);
+
+    let result = read_fragment(&format, init_data, fragment_data);
+
+    match result {
+        Ok(json) => to_c_string(json),
+        Err(e) => {
+            e.set_last();
+            std::ptr::null_mut()
+        }
+    }
+}
+
+/// Returns a ManifestStore JSON string from a file path, honoring read flags
+/// With C2PA_READ_SKIP_RESOURCES set no thumbnails or other binary resources
+/// are written to data_dir, so metadata-only readers skip that cost
 ///
 /// # Errors
 /// Returns NULL if there were errors, otherwise returns a JSON string
-/// containing the Ingredient
 /// The error string can be retrieved by calling c2pa_error
 ///
 /// # Safety
@@ -130,14 +406,15 @@ pub unsafe extern "C" fn c2pa_read_file(
 /// The returned value MUST be released by calling release_string
 /// and it is no longer valid after that call.
 #[no_mangle]
-pub unsafe extern "C" fn c2pa_read_ingredient_file(
+pub unsafe extern "C" fn c2pa_read_file_with_flags(
     path: *const c_char,
     data_dir: *const c_char,
+    flags: u32,
 ) -> *mut c_char {
     let path = from_cstr_null_check!(path);
-    let data_dir = from_cstr_null_check!(data_dir);
+    let data_dir = from_cstr_option!(data_dir);
 
-    let result = read_ingredient_file(&path, &data_dir);
+    let result = read_file_with_flags(&path, data_dir, flags);
 
     match result {
         Ok(json) => to_c_string(json),
@@ -148,58 +425,153 @@ pub unsafe extern "C" fn c2pa_read_ingredient_file(
     }
 }
 
-#[repr(C)]
-/// Defines the configuration for a Signer
+/// Writes the ManifestStore JSON report for a file path through the write
+/// callback in chunks
 ///
-/// The signer is created from the signcert and pkey fields.
-/// an optional url to an RFC 3161 compliant time server will ensure the signature is timestamped
+/// The report is identical to the one c2pa_read_file returns, but it is
+/// serialized straight into caller chunks of up to 64 KB instead of one
+/// giant string, so peak memory stays bounded no matter how many
+/// ingredients the store carries. No binary resources are written.
+/// The callback returns the number of bytes it consumed, or a negative
+/// value to abort; its data pointer is only valid during the call
 ///
-pub struct C2paSignerInfo {
-    /// The signing algorithm
-    pub alg: *const c_char,
-    /// The public certificate chain in PEM format
-    pub sign_cert: *const c_char,
-    /// The private key in PEM format
-    pub private_key: *const c_char,
-    /// The timestamp authority URL or NULL
-    pub ta_url: *const c_char,
+/// # Errors
+/// Returns -1 if there were errors, otherwise 0
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// Reads from a null terminated C string
+/// The context must remain valid until this call returns
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_read_file_stream(
+    path: *const c_char,
+    callback: unsafe extern "C" fn(data: *const u8, len: usize, context: *mut c_void) -> isize,
+    context: *mut c_void,
+) -> std::os::raw::c_int {
+    let path = from_cstr_size_check!(path);
+
+    struct CallbackWriter {
+        callback: unsafe extern "C" fn(data: *const u8, len: usize, context: *mut c_void) -> isize,
+        context: *mut c_void,
+    }
+    impl std::io::Write for CallbackWriter {
+        fn write(&mut self, buf: &[u8]) -> std::io::Result<usize> {
+            let written = unsafe { (self.callback)(buf.as_ptr(), buf.len(), self.context) };
+            if written < 0 {
+                return Err(std::io::Error::other("write callback failed"));
+            }
+            Ok(written as usize)
+        }
+        fn flush(&mut self) -> std::io::Result<()> {
+            Ok(())
+        }
+    }
+
+    // the serializer emits many small pieces; buffering delivers the report
+    // to the callback in sizeable chunks instead
+    let mut writer =
+        std::io::BufWriter::with_capacity(64 * 1024, CallbackWriter { callback, context });
+    let result = read_file_stream(&path, &mut writer)
+        .and_then(|_| std::io::Write::flush(&mut writer).map_err(|e| Error::Io(e.to_string())));
+
+    match result {
+        Ok(()) => 0,
+        Err(e) => {
+            e.set_last();
+            -1
+        }
+    }
 }
 
-/// Add a signed manifest to the file at path using auth_token
-/// If cloud is true, upload the manifest to the cloud
+/// Returns a ManifestStore report from a file path as compact CBOR
+///
+/// The report has the same structure as the JSON from c2pa_read_file but
+/// skips the JSON text round trip, which is faster to parse and smaller on
+/// the wire. The report length is returned via the len parameter. No binary
+/// resources are written.
 ///
 /// # Errors
-/// Returns an error field if there were errors
+/// Returns NULL if there were errors, otherwise returns the CBOR bytes
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// Reads from null terminated C strings
+/// The returned value MUST be released by calling c2pa_release_buffer
+/// and it is no longer valid after that call.
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_read_file_cbor(path: *const c_char, len: *mut usize) -> *mut u8 {
+    let path = from_cstr_null_check!(path);
+
+    let result = read_file_cbor(&path);
+
+    match result {
+        Ok(cbor) => to_c_buffer(cbor, len),
+        Err(e) => {
+            e.set_last();
+            std::ptr::null_mut()
+        }
+    }
+}
+
+/// Returns an Ingredient report from a file path as compact CBOR
+///
+/// The report has the same structure as the JSON from
+/// c2pa_read_ingredient_file but skips the JSON text round trip. The report
+/// length is returned via the len parameter. No binary resources are written.
+///
+/// # Errors
+/// Returns NULL if there were errors, otherwise returns the CBOR bytes
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// Reads from null terminated C strings
+/// The returned value MUST be released by calling c2pa_release_buffer
+/// and it is no longer valid after that call.
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_read_ingredient_file_cbor(
+    path: *const c_char,
+    len: *mut usize,
+) -> *mut u8 {
+    let path = from_cstr_null_check!(path);
+
+    let result = read_ingredient_file_cbor(&path);
+
+    match result {
+        Ok(cbor) => to_c_buffer(cbor, len),
+        Err(e) => {
+            e.set_last();
+            std::ptr::null_mut()
+        }
+    }
+}
+
+/// Returns an Ingredient JSON string from a file path, honoring read flags
+/// With C2PA_READ_SKIP_RESOURCES set no thumbnail or c2pa data is written to
+/// data_dir; with C2PA_READ_SKIP_THUMBNAILS set no thumbnail is decoded or
+/// generated for assets that do not already carry one
+///
+/// # Errors
+/// Returns NULL if there were errors, otherwise returns a JSON string
+/// containing the Ingredient
+/// The error string can be retrieved by calling c2pa_error
 ///
 /// # Safety
 /// Reads from null terminated C strings
 /// The returned value MUST be released by calling release_string
 /// and it is no longer valid after that call.
 #[no_mangle]
-pub unsafe extern "C" fn c2pa_sign_file(
-    source_path: *const c_char,
-    dest_path: *const c_char,
-    manifest: *const c_char,
-    signer_info: &C2paSignerInfo,
+pub unsafe extern "C" fn c2pa_read_ingredient_file_with_flags(
+    path: *const c_char,
     data_dir: *const c_char,
+    flags: u32,
 ) -> *mut c_char {
-    // convert C pointers into Rust
-    let source_path = from_cstr_null_check!(source_path);
-    let dest_path = from_cstr_null_check!(dest_path);
-    let manifest = from_cstr_null_check!(manifest);
-    let data_dir = from_cstr_option!(data_dir);
+    let path = from_cstr_null_check!(path);
+    let data_dir = from_cstr_null_check!(data_dir);
 
-    let signer_info = SignerInfo {
-        alg: from_cstr_null_check!(signer_info.alg),
-        sign_cert: from_cstr_null_check!(signer_info.sign_cert).into_bytes(),
-        private_key: from_cstr_null_check!(signer_info.private_key).into_bytes(),
-        ta_url: from_cstr_option!(signer_info.ta_url),
-    };
-    // Read manifest from JSON and then sign and write it
-    let result = sign_file(&source_path, &dest_path, &manifest, &signer_info, data_dir);
+    let result = read_ingredient_file_with_flags(&path, &data_dir, flags);
 
     match result {
-        Ok(_c2pa_data) => to_c_string("".to_string()),
+        Ok(json) => to_c_string(json),
         Err(e) => {
             e.set_last();
             std::ptr::null_mut()
@@ -207,16 +579,1629 @@ pub unsafe extern "C" fn c2pa_sign_file(
     }
 }
 
-/// Releases a string allocated by Rust
+/// Returns an Ingredient JSON string from a file path, honoring extraction
+/// options for binary resources
+///
+/// flags is a combination of the C2PA_READ_* flags.
+/// max_thumbnail_dimension downscales a thumbnail generated from the asset
+/// to that many pixels on its longest edge; zero keeps the default of 1024.
+/// max_resource_bytes drops any resource larger than the cap; zero means no
+/// cap.
+/// When callback is non NULL every extracted resource is delivered through
+/// it instead of being written to disk; the id string and data pointer are
+/// only valid for the duration of the call. Otherwise resources are written
+/// under data_dir, which may be NULL to extract none
+///
+/// # Errors
+/// Returns NULL if there were errors, otherwise returns a JSON string
+/// The error string can be retrieved by calling c2pa_error
 ///
 /// # Safety
 /// Reads from null terminated C strings
-/// The string must not have been modified in C
-/// can only be released once and is invalid after this call
+/// The returned value MUST be released by calling release_string
+/// and it is no longer valid after that call.
 #[no_mangle]
-pub unsafe extern "C" fn c2pa_release_string(s: *mut c_char) {
-    if s.is_null() {
+pub unsafe extern "C" fn c2pa_read_ingredient_file_with_options(
+    path: *const c_char,
+    data_dir: *const c_char,
+    flags: u32,
+    max_thumbnail_dimension: u32,
+    max_resource_bytes: u64,
+    callback: Option<
+        unsafe extern "C" fn(id: *const c_char, data: *const u8, len: usize, context: *mut c_void),
+    >,
+    context: *mut c_void,
+) -> *mut c_char {
+    let path = from_cstr_null_check!(path);
+    let data_dir = from_cstr_option!(data_dir);
+    let options = IngredientExtractOptions {
+        flags,
+        max_thumbnail_dimension,
+        max_resource_bytes,
+    };
+
+    let mut deliver = callback.map(|callback| {
+        move |id: &str, data: &[u8]| {
+            if let Ok(id) = CString::new(id) {
+                callback(id.as_ptr(), data.as_ptr(), data.len(), context);
+            }
+        }
+    });
+    let result = read_ingredient_file_with_options(
+        &path,
+        data_dir.as_deref(),
+        &options,
+        deliver
+            .as_mut()
+            .map(|deliver| deliver as &mut dyn FnMut(&str, &[u8])),
+    );
+
+    match result {
+        Ok(json) => to_c_string(json),
+        Err(e) => {
+            e.set_last();
+            std::ptr::null_mut()
+        }
+    }
+}
+
+/// Returns a JSON object holding only the selected fields of the active manifest
+/// labels is a comma separated list of assertion labels and/or the special
+/// fields "title", "claim_generator" and "validation_status"
+/// Only the requested values are serialized, avoiding the cost of building
+/// and re-parsing a whole ManifestStore report
+///
+/// # Errors
+/// Returns NULL if there were errors, otherwise returns a JSON string
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// Reads from null terminated C strings
+/// The returned value MUST be released by calling release_string
+/// and it is no longer valid after that call.
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_read_file_selected(
+    path: *const c_char,
+    labels: *const c_char,
+) -> *mut c_char {
+    let path = from_cstr_null_check!(path);
+    let labels = from_cstr_null_check!(labels);
+
+    let result = read_file_selected(&path, &labels);
+
+    match result {
+        Ok(json) => to_c_string(json),
+        Err(e) => {
+            e.set_last();
+            std::ptr::null_mut()
+        }
+    }
+}
+
+/// Returns whether the asset at path contains a C2PA manifest store
+/// Only container headers are scanned; the store is not deserialized or
+/// validated, so this is a fast way to skip assets with no C2PA data
+///
+/// # Errors
+/// Returns 1 if a manifest store is present, 0 if not, and -1 on error
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// Reads from null terminated C strings
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_has_manifest(path: *const c_char) -> std::os::raw::c_int {
+    if path.is_null() {
+        Error::set_last(Error::NullParameter("path".to_string()));
+        return -1;
+    }
+    let path = from_c_str(path);
+
+    match has_manifest(&path) {
+        Ok(true) => 1,
+        Ok(false) => 0,
+        Err(e) => {
+            e.set_last();
+            -1
+        }
+    }
+}
+
+/// Returns an Ingredient JSON string from a file path.
+/// Any thumbnail or c2pa data will be written to data_dir if provided
+///
+/// # Errors
+/// Returns NULL if there were errors, otherwise returns a JSON string
+/// containing the Ingredient
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// Reads from null terminated C strings
+/// The returned value MUST be released by calling release_string
+/// and it is no longer valid after that call.
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_read_ingredient_file(
+    path: *const c_char,
+    data_dir: *const c_char,
+) -> *mut c_char {
+    let path = from_cstr_null_check!(path);
+    let data_dir = from_cstr_null_check!(data_dir);
+
+    let result = read_ingredient_file(&path, &data_dir);
+
+    match result {
+        Ok(json) => to_c_string(json),
+        Err(e) => {
+            e.set_last();
+            std::ptr::null_mut()
+        }
+    }
+}
+
+/// Writes an Ingredient JSON string from a file path into a caller buffer
+/// Any thumbnail or c2pa data will be written to data_dir
+///
+/// See c2pa_read_file_into for the buffer contract; the json is only
+/// written, null terminated, when the buffer is large enough and nothing
+/// needs to be released.
+///
+/// # Errors
+/// Returns the required buffer size in bytes including the null terminator,
+/// or -1 if there were errors
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// Reads from null terminated C strings
+/// Writes at most buf_len bytes to buf, which may be NULL to query the size
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_read_ingredient_file_into(
+    path: *const c_char,
+    data_dir: *const c_char,
+    buf: *mut c_char,
+    buf_len: usize,
+) -> i64 {
+    let path = from_cstr_size_check!(path);
+    let data_dir = from_cstr_size_check!(data_dir);
+
+    let result = read_ingredient_file(&path, &data_dir);
+
+    match result {
+        Ok(json) => string_into_buffer(json, buf, buf_len),
+        Err(e) => {
+            e.set_last();
+            -1
+        }
+    }
+}
+
+#[cfg(feature = "signing")]
+#[repr(C)]
+/// Defines the configuration for a Signer
+///
+/// The signer is created from the signcert and pkey fields.
+/// an optional url to an RFC 3161 compliant time server will ensure the signature is timestamped
+///
+pub struct C2paSignerInfo {
+    /// The signing algorithm
+    pub alg: *const c_char,
+    /// The public certificate chain in PEM format
+    pub sign_cert: *const c_char,
+    /// The private key in PEM format
+    pub private_key: *const c_char,
+    /// The timestamp authority URL or NULL
+    pub ta_url: *const c_char,
+}
+
+/// Returns a ManifestStore JSON string from a C2paStream
+/// The format must be a supported mime type or extension (e.g. "image/jpeg" or "jpg")
+///
+/// # Errors
+/// Returns NULL if there were errors, otherwise returns a JSON string
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// The stream must be a valid C2paStream and remains owned by the caller
+/// The returned value MUST be released by calling release_string
+/// and it is no longer valid after that call.
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_read_stream(
+    stream: *mut C2paStream,
+    format: *const c_char,
+) -> *mut c_char {
+    if stream.is_null() {
+        Error::set_last(Error::NullParameter("stream".to_string()));
+        return std::ptr::null_mut();
+    }
+    let format = from_cstr_null_check!(format);
+
+    let result = read_stream(&format, &mut *stream);
+
+    match result {
+        Ok(json) => to_c_string(json),
+        Err(e) => {
+            e.set_last();
+            std::ptr::null_mut()
+        }
+    }
+}
+
+/// Returns an Ingredient JSON string from a C2paStream
+/// The format must be a supported mime type or extension (e.g. "image/jpeg" or "jpg")
+///
+/// # Errors
+/// Returns NULL if there were errors, otherwise returns a JSON string
+/// containing the Ingredient
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// The stream must be a valid C2paStream and remains owned by the caller
+/// The returned value MUST be released by calling release_string
+/// and it is no longer valid after that call.
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_read_ingredient_stream(
+    stream: *mut C2paStream,
+    format: *const c_char,
+) -> *mut c_char {
+    if stream.is_null() {
+        Error::set_last(Error::NullParameter("stream".to_string()));
+        return std::ptr::null_mut();
+    }
+    let format = from_cstr_null_check!(format);
+
+    let result = read_ingredient_stream(&format, &mut *stream);
+
+    match result {
+        Ok(json) => to_c_string(json),
+        Err(e) => {
+            e.set_last();
+            std::ptr::null_mut()
+        }
+    }
+}
+
+/// Add a signed manifest read from a source C2paStream and write the signed asset
+/// to a destination C2paStream
+/// The format must be a supported mime type or extension (e.g. "image/jpeg" or "jpg")
+///
+/// # Errors
+/// Returns NULL if there were errors, otherwise returns an empty string
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// The streams must be valid C2paStreams and remain owned by the caller
+/// The signer handle must be valid and not freed during the call
+/// The returned value MUST be released by calling release_string
+/// and it is no longer valid after that call.
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_sign_stream(
+    source: *mut C2paStream,
+    dest: *mut C2paStream,
+    format: *const c_char,
+    manifest: *const c_char,
+    signer: *const C2paSigner,
+) -> *mut c_char {
+    if source.is_null() {
+        Error::set_last(Error::NullParameter("source".to_string()));
+        return std::ptr::null_mut();
+    }
+    if dest.is_null() {
+        Error::set_last(Error::NullParameter("dest".to_string()));
+        return std::ptr::null_mut();
+    }
+    if signer.is_null() {
+        Error::set_last(Error::NullParameter("signer".to_string()));
+        return std::ptr::null_mut();
+    }
+    let format = from_cstr_null_check!(format);
+    let manifest = from_cstr_null_check!(manifest);
+
+    let result = sign_stream(
+        &format,
+        &mut *source,
+        &mut *dest,
+        &manifest,
+        &*(*signer).signer,
+    );
+
+    match result {
+        Ok(_c2pa_data) => to_c_string("".to_string()),
+        Err(e) => {
+            e.set_last();
+            std::ptr::null_mut()
+        }
+    }
+}
+
+/// An opaque handle holding a compiled manifest template
+///
+/// The manifest definition JSON is parsed and validated once when the handle
+/// is created, removing a serde pass from every sign call that reuses it.
+#[cfg(feature = "signing")]
+pub struct C2paManifestTemplate {
+    template: ManifestTemplate,
+}
+
+/// Parses and validates a manifest definition JSON into a reusable template handle
+///
+/// # Errors
+/// Returns NULL if there were errors, otherwise returns a template handle
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// Reads from null terminated C strings
+/// The returned value MUST be released by calling c2pa_manifest_template_free
+/// and it is no longer valid after that call.
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_manifest_compile(
+    manifest: *const c_char,
+) -> *mut C2paManifestTemplate {
+    let manifest = from_cstr_null_check!(manifest);
+
+    match compile_manifest(&manifest) {
+        Ok(template) => Box::into_raw(Box::new(C2paManifestTemplate { template })),
+        Err(e) => {
+            e.set_last();
+            std::ptr::null_mut()
+        }
+    }
+}
+
+/// Add a signed manifest built from a compiled template to the file at path
+/// overlay, if not NULL, is a small JSON object of per-asset top-level fields
+/// (e.g. title) merged over the template
+/// flags accepts C2PA_SIGN_SKIP_PARENT_CHECK
+///
+/// # Errors
+/// Returns NULL if there were errors, otherwise returns an empty string
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// Reads from null terminated C strings
+/// The template and signer handles must be valid and not freed during the call
+/// The returned value MUST be released by calling release_string
+/// and it is no longer valid after that call.
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_sign_file_with_template(
+    source_path: *const c_char,
+    dest_path: *const c_char,
+    template: *const C2paManifestTemplate,
+    overlay: *const c_char,
+    signer: *const C2paSigner,
+    flags: u32,
+    data_dir: *const c_char,
+) -> *mut c_char {
+    if template.is_null() {
+        Error::set_last(Error::NullParameter("template".to_string()));
+        return std::ptr::null_mut();
+    }
+    if signer.is_null() {
+        Error::set_last(Error::NullParameter("signer".to_string()));
+        return std::ptr::null_mut();
+    }
+    let source_path = from_cstr_null_check!(source_path);
+    let dest_path = from_cstr_null_check!(dest_path);
+    let overlay = from_cstr_option!(overlay);
+    let data_dir = from_cstr_option!(data_dir);
+
+    let result = sign_file_with_template(
+        &source_path,
+        &dest_path,
+        &(*template).template,
+        overlay.as_deref(),
+        &*(*signer).signer,
+        flags,
+        data_dir,
+    );
+
+    match result {
+        Ok(_c2pa_data) => to_c_string("".to_string()),
+        Err(e) => {
+            e.set_last();
+            std::ptr::null_mut()
+        }
+    }
+}
+
+/// Frees a manifest template handle created by c2pa_manifest_compile
+///
+/// # Safety
+/// The handle can only be freed once and is invalid after this call
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_manifest_template_free(template: *mut C2paManifestTemplate) {
+    if template.is_null() {
+        return;
+    }
+    let _release = Box::from_raw(template);
+}
+
+// A process wide pool shared by every c2pa_sign_file_async call, created
+// on first use and sized to the available parallelism of the host. A burst
+// of async calls queues here instead of spawning one detached thread each.
+#[cfg(feature = "signing")]
+fn async_sign_pool() -> &'static std::sync::Mutex<std::sync::mpsc::Sender<Box<dyn FnOnce() + Send>>>
+{
+    use std::sync::{mpsc, Arc, Mutex, OnceLock};
+
+    type AsyncSignJob = Box<dyn FnOnce() + Send>;
+
+    static POOL: OnceLock<Mutex<mpsc::Sender<AsyncSignJob>>> = OnceLock::new();
+    POOL.get_or_init(|| {
+        let threads = std::thread::available_parallelism()
+            .map(|n| n.get())
+            .unwrap_or(1);
+        let (sender, receiver) = mpsc::channel::<AsyncSignJob>();
+        let receiver = Arc::new(Mutex::new(receiver));
+        for _ in 0..threads {
+            let receiver = receiver.clone();
+            std::thread::spawn(move || loop {
+                let job = match receiver.lock() {
+                    Ok(receiver) => receiver.recv(),
+                    Err(_) => return,
+                };
+                let Ok(job) = job else { return };
+                job();
+            });
+        }
+        Mutex::new(sender)
+    })
+}
+
+/// Add a signed manifest to the file at path on a shared worker pool,
+/// invoking the callback when the sign completes
+/// The pool is sized to the available parallelism of the host, so one
+/// thread can keep many signs in flight and timestamp-authority round
+/// trips overlap, while a burst of calls queues instead of spawning an
+/// unbounded number of threads
+///
+/// # Errors
+/// Returns -1 if the sign could not be started; once 0 is returned the
+/// callback always runs, receiving an error message or NULL on success
+///
+/// # Safety
+/// Reads from null terminated C strings
+/// The callback may be invoked from another thread and must be thread safe;
+/// its error pointer is only valid during the callback
+/// The context must remain valid until the callback has run
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_sign_file_async(
+    source_path: *const c_char,
+    dest_path: *const c_char,
+    manifest: *const c_char,
+    signer_info: &C2paSignerInfo,
+    data_dir: *const c_char,
+    callback: unsafe extern "C" fn(error: *const c_char, context: *mut c_void),
+    context: *mut c_void,
+) -> i64 {
+    let source_path = from_cstr_size_check!(source_path);
+    let dest_path = from_cstr_size_check!(dest_path);
+    let manifest = from_cstr_size_check!(manifest);
+    let data_dir = from_cstr_option!(data_dir);
+
+    let signer_info = SignerInfo {
+        alg: from_cstr_size_check!(signer_info.alg),
+        sign_cert: from_cstr_size_check!(signer_info.sign_cert).into_bytes(),
+        private_key: from_cstr_size_check!(signer_info.private_key).into_bytes(),
+        ta_url: from_cstr_option!(signer_info.ta_url),
+    };
+
+    let batch_context = BatchContext(context);
+    let job = Box::new(move || {
+        let context = batch_context;
+        let result = sign_file(&source_path, &dest_path, &manifest, &signer_info, data_dir);
+        match result {
+            Ok(_) => callback(std::ptr::null(), context.0),
+            Err(e) => {
+                // an error text with an interior NUL cannot become a C
+                // string; fall back to a fixed message rather than leaving
+                // the caller waiting on a callback that never runs
+                let message = CString::new(e.to_string())
+                    .unwrap_or_else(|_| CString::from(c"signing failed"));
+                callback(message.as_ptr(), context.0);
+            }
+        }
+    });
+    let queued = match async_sign_pool().lock() {
+        Ok(sender) => sender.send(job).is_ok(),
+        Err(_) => false,
+    };
+    if !queued {
+        Error::set_last(Error::Other("async sign pool unavailable".to_string()));
+        return -1;
+    }
+    0
+}
+
+/// An opaque handle holding a precomputed Ingredient
+///
+/// Building the ingredient reads and hashes the asset; doing it once and
+/// passing the handle to a sign call avoids the hidden second pass over the
+/// source that parent detection would otherwise make.
+#[cfg(feature = "signing")]
+pub struct C2paIngredient {
+    ingredient: Option<c2pa::Ingredient>,
+}
+
+/// Builds an Ingredient from the file at path, returning an opaque handle
+///
+/// The handle can be passed to c2pa_sign_file_with_ingredient as the parent,
+/// which consumes its contents; a handle can only be used for one sign call
+///
+/// # Errors
+/// Returns NULL if there were errors, otherwise returns an ingredient handle
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// Reads from null terminated C strings
+/// The returned value MUST be released by calling c2pa_ingredient_free
+/// and it is no longer valid after that call.
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_ingredient_from_file(path: *const c_char) -> *mut C2paIngredient {
+    let path = from_cstr_null_check!(path);
+
+    match c2pa::Ingredient::from_file(&path) {
+        Ok(ingredient) => Box::into_raw(Box::new(C2paIngredient {
+            ingredient: Some(ingredient),
+        })),
+        Err(e) => {
+            Error::from_c2pa_error(e).set_last();
+            std::ptr::null_mut()
+        }
+    }
+}
+
+/// Add a signed manifest to the file at path using a signer handle and a
+/// precomputed parent ingredient
+/// If parent is not NULL its ingredient is used as the manifest parent and
+/// consumed; if parent is NULL and flags contains C2PA_SIGN_SKIP_PARENT_CHECK
+/// the source is not scanned for an existing manifest store
+///
+/// # Errors
+/// Returns NULL if there were errors, otherwise returns an empty string
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// Reads from null terminated C strings
+/// The signer and ingredient handles must be valid and not freed during the call
+/// The returned value MUST be released by calling release_string
+/// and it is no longer valid after that call.
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_sign_file_with_ingredient(
+    source_path: *const c_char,
+    dest_path: *const c_char,
+    manifest: *const c_char,
+    signer: *const C2paSigner,
+    parent: *mut C2paIngredient,
+    flags: u32,
+    data_dir: *const c_char,
+) -> *mut c_char {
+    if signer.is_null() {
+        Error::set_last(Error::NullParameter("signer".to_string()));
+        return std::ptr::null_mut();
+    }
+    let source_path = from_cstr_null_check!(source_path);
+    let dest_path = from_cstr_null_check!(dest_path);
+    let manifest = from_cstr_null_check!(manifest);
+    let data_dir = from_cstr_option!(data_dir);
+
+    let parent = if parent.is_null() {
+        None
+    } else {
+        match (*parent).ingredient.take() {
+            Some(ingredient) => Some(ingredient),
+            None => {
+                Error::set_last(Error::Other("ingredient already used".to_string()));
+                return std::ptr::null_mut();
+            }
+        }
+    };
+
+    let result = sign_file_with_options(
+        &source_path,
+        &dest_path,
+        &manifest,
+        &*(*signer).signer,
+        parent,
+        flags,
+        data_dir,
+    );
+
+    match result {
+        Ok(_c2pa_data) => to_c_string("".to_string()),
+        Err(e) => {
+            e.set_last();
+            std::ptr::null_mut()
+        }
+    }
+}
+
+/// Frees an ingredient handle created by c2pa_ingredient_from_file
+///
+/// # Safety
+/// The handle can only be freed once and is invalid after this call
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_ingredient_free(ingredient: *mut C2paIngredient) {
+    if ingredient.is_null() {
+        return;
+    }
+    let _release = Box::from_raw(ingredient);
+}
+
+/// Sets the time to live in seconds for cached timestamp authority responses
+///
+/// While set, a repeated timestamp request for the same message within the
+/// window is answered from the cache instead of a new round trip to the
+/// timestamp server. Cached responses are only returned for byte identical
+/// messages, so signed output is unaffected. Setting zero (the default)
+/// disables the cache and drops any cached responses.
+///
+/// # Safety
+/// May be called from any thread at any time
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_set_timestamp_cache_ttl(seconds: u64) {
+    set_timestamp_cache_ttl(seconds);
+}
+
+/// Registers a process-wide trace callback reporting per-stage timings of
+/// the read and sign paths, or unregisters it when callback is NULL
+///
+/// The callback receives the stage identifier (see C2paTraceStage, stable
+/// values suitable for recording), the wall clock start in nanoseconds
+/// since the unix epoch, the elapsed nanoseconds, the payload size in
+/// bytes the stage worked over (0 when not meaningful) and the context.
+/// When no callback is registered the instrumented paths only pay one
+/// atomic load per stage.
+///
+/// # Safety
+/// The callback may be invoked from any thread, including internal worker
+/// threads, and must be thread safe along with its context
+/// The context must remain valid until the callback is unregistered
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_set_trace_callback(
+    callback: Option<
+        unsafe extern "C" fn(
+            stage: C2paTraceStage,
+            start_ns: u64,
+            duration_ns: u64,
+            bytes: u64,
+            context: *mut c_void,
+        ),
+    >,
+    context: *mut c_void,
+) {
+    set_trace_callback(callback, context);
+}
+
+/// An opaque handle holding a reusable signer
+///
+/// The certificates and private key are parsed once when the handle is
+/// created so they do not need to be re-parsed on every sign call.
+#[cfg(feature = "signing")]
+pub struct C2paSigner {
+    signer: Box<dyn c2pa::Signer>,
+}
+
+/// Creates a reusable signer handle from the signer_info fields
+///
+/// # Errors
+/// Returns NULL if there were errors, otherwise returns a signer handle
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// Reads from null terminated C strings
+/// The returned value MUST be released by calling c2pa_signer_free
+/// and it is no longer valid after that call.
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_signer_create(signer_info: &C2paSignerInfo) -> *mut C2paSigner {
+    let signer_info = SignerInfo {
+        alg: from_cstr_null_check!(signer_info.alg),
+        sign_cert: from_cstr_null_check!(signer_info.sign_cert).into_bytes(),
+        private_key: from_cstr_null_check!(signer_info.private_key).into_bytes(),
+        ta_url: from_cstr_option!(signer_info.ta_url),
+    };
+
+    match signer_info.signer() {
+        Ok(signer) => Box::into_raw(Box::new(C2paSigner { signer })),
+        Err(e) => {
+            e.set_last();
+            std::ptr::null_mut()
+        }
+    }
+}
+
+/// Add a signed manifest to the file at path using a signer handle
+/// created by c2pa_signer_create
+///
+/// # Errors
+/// Returns NULL if there were errors, otherwise returns an empty string
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// Reads from null terminated C strings
+/// The signer handle must be valid and not freed during the call
+/// The returned value MUST be released by calling release_string
+/// and it is no longer valid after that call.
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_sign_file_with_signer(
+    source_path: *const c_char,
+    dest_path: *const c_char,
+    manifest: *const c_char,
+    signer: *const C2paSigner,
+    data_dir: *const c_char,
+) -> *mut c_char {
+    if signer.is_null() {
+        Error::set_last(Error::NullParameter("signer".to_string()));
+        return std::ptr::null_mut();
+    }
+    let source_path = from_cstr_null_check!(source_path);
+    let dest_path = from_cstr_null_check!(dest_path);
+    let manifest = from_cstr_null_check!(manifest);
+    let data_dir = from_cstr_option!(data_dir);
+
+    let result = sign_file_with_signer(
+        &source_path,
+        &dest_path,
+        &manifest,
+        &*(*signer).signer,
+        data_dir,
+    );
+
+    match result {
+        Ok(_c2pa_data) => to_c_string("".to_string()),
+        Err(e) => {
+            e.set_last();
+            std::ptr::null_mut()
+        }
+    }
+}
+
+/// Re-signs an already signed asset with an updated manifest using a signer
+/// handle, reusing the existing hard binding instead of re-hashing the asset
+/// A metadata only update skips the hashing and ingredient validation passes
+/// over the asset bytes, though the destination file is still rewritten when
+/// the new store is spliced in; the previous manifests are preserved as the
+/// parent of the new claim
+/// The recorded digest is trusted as is; use c2pa_sign_file when the source
+/// asset cannot be trusted
+///
+/// # Errors
+/// Returns NULL if there were errors, otherwise returns an empty string
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// Reads from null terminated C strings
+/// The signer handle must be valid and not freed during the call
+/// The returned value MUST be released by calling release_string
+/// and it is no longer valid after that call.
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_resign_file(
+    source_path: *const c_char,
+    dest_path: *const c_char,
+    manifest: *const c_char,
+    signer: *const C2paSigner,
+    data_dir: *const c_char,
+) -> *mut c_char {
+    if signer.is_null() {
+        Error::set_last(Error::NullParameter("signer".to_string()));
+        return std::ptr::null_mut();
+    }
+    let source_path = from_cstr_null_check!(source_path);
+    let dest_path = from_cstr_null_check!(dest_path);
+    let manifest = from_cstr_null_check!(manifest);
+    let data_dir = from_cstr_option!(data_dir);
+
+    let result = resign_file(
+        &source_path,
+        &dest_path,
+        &manifest,
+        &*(*signer).signer,
+        data_dir,
+    );
+
+    match result {
+        Ok(_c2pa_data) => to_c_string("".to_string()),
+        Err(e) => {
+            e.set_last();
+            std::ptr::null_mut()
+        }
+    }
+}
+
+/// Add a signed manifest to an asset in memory using a signer handle
+/// created by c2pa_signer_create, returning the signed asset
+/// The length of the signed asset is returned via signed_len
+///
+/// # Errors
+/// Returns NULL if there were errors, otherwise returns the signed asset bytes
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// Reads len bytes from the data pointer, which must remain valid for the call
+/// The signer handle must be valid and not freed during the call
+/// The returned value MUST be released by calling release_buffer
+/// and it is no longer valid after that call.
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_sign_buffer_with_signer(
+    data: *const u8,
+    len: usize,
+    format: *const c_char,
+    manifest: *const c_char,
+    signer: *const C2paSigner,
+    signed_len: *mut usize,
+) -> *mut u8 {
+    if data.is_null() {
+        Error::set_last(Error::NullParameter("data".to_string()));
+        return std::ptr::null_mut();
+    }
+    if signer.is_null() {
+        Error::set_last(Error::NullParameter("signer".to_string()));
+        return std::ptr::null_mut();
+    }
+    let format = from_cstr_null_check!(format);
+    let manifest = from_cstr_null_check!(manifest);
+    let data = std::slice::from_raw_parts(data, len);
+
+    let result = sign_buffer_with_signer(&format, data, &manifest, &*(*signer).signer);
+
+    match result {
+        Ok(signed) => to_c_buffer(signed, signed_len),
+        Err(e) => {
+            e.set_last();
+            std::ptr::null_mut()
+        }
+    }
+}
+
+/// An opaque handle holding a cache of verification results
+///
+/// Results are keyed by (file size, mtime, manifest box hash), so a cached
+/// report is only returned while the asset and its manifest store are
+/// unchanged. The handle is safe to share across threads.
+pub struct C2paReaderCache {
+    cache: ReaderCache,
+}
+
+/// Creates a verification result cache holding up to capacity entries
+///
+/// Entries are evicted least recently used once capacity is reached
+///
+/// # Safety
+/// The returned value MUST be released by calling c2pa_reader_cache_free
+/// and it is no longer valid after that call.
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_reader_cache_create(capacity: usize) -> *mut C2paReaderCache {
+    Box::into_raw(Box::new(C2paReaderCache {
+        cache: ReaderCache::new(capacity),
+    }))
+}
+
+/// Returns a ManifestStore JSON string from a file path, consulting the cache
+///
+/// On a hit the cached report is returned without re-parsing or re-validating
+/// the manifest store; only the file metadata and manifest box are read to
+/// confirm the content identity. No binary resources are written.
+///
+/// # Errors
+/// Returns NULL if there were errors, otherwise returns a JSON string
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// Reads from null terminated C strings
+/// The returned value MUST be released by calling release_string
+/// and it is no longer valid after that call.
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_read_file_cached(
+    cache: *const C2paReaderCache,
+    path: *const c_char,
+) -> *mut c_char {
+    if cache.is_null() {
+        Error::set_last(Error::NullParameter("cache".to_string()));
+        return std::ptr::null_mut();
+    }
+    let path = from_cstr_null_check!(path);
+
+    let result = read_file_cached(&(*cache).cache, &path);
+
+    match result {
+        Ok(json) => to_c_string(json),
+        Err(e) => {
+            e.set_last();
+            std::ptr::null_mut()
+        }
+    }
+}
+
+/// Returns the hit and miss counts of a verification result cache
+///
+/// # Safety
+/// The cache must be a valid handle from c2pa_reader_cache_create
+/// hits and misses are written if non NULL
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_reader_cache_stats(
+    cache: *const C2paReaderCache,
+    hits: *mut u64,
+    misses: *mut u64,
+) {
+    if cache.is_null() {
+        Error::set_last(Error::NullParameter("cache".to_string()));
+        return;
+    }
+    let (cache_hits, cache_misses) = (*cache).cache.stats();
+    if !hits.is_null() {
+        *hits = cache_hits;
+    }
+    if !misses.is_null() {
+        *misses = cache_misses;
+    }
+}
+
+/// Releases a cache created by c2pa_reader_cache_create
+///
+/// # Safety
+/// The cache can no longer be used after this call
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_reader_cache_free(cache: *mut C2paReaderCache) {
+    if !cache.is_null() {
+        drop(Box::from_raw(cache));
+    }
+}
+
+/// Returns the size in bytes a signer reserves for its signature box
+///
+/// Pass this to c2pa_manifest_data_hash_placeholder as the reserve_size
+/// when the same signer will sign the manifest
+///
+/// # Safety
+/// The signer must be a valid handle from c2pa_signer_create
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_signer_reserve_size(signer: *const C2paSigner) -> usize {
+    if signer.is_null() {
+        Error::set_last(Error::NullParameter("signer".to_string()));
+        return 0;
+    }
+    (*signer).signer.reserve_size()
+}
+
+/// Sets the chunk size in bytes for the data hash read/hash pipeline
+///
+/// Zero restores the default of 8 MB
+///
+/// # Safety
+/// May be called from any thread at any time
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_set_hash_chunk_size(bytes: usize) {
+    set_hash_chunk_size(bytes);
+}
+
+/// Sets how many chunks the reader thread may buffer ahead of the hasher
+/// in the data hash pipeline
+///
+/// Zero restores the default of 4 chunks
+///
+/// # Safety
+/// May be called from any thread at any time
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_set_hash_readahead_chunks(chunks: usize) {
+    set_hash_readahead_chunks(chunks);
+}
+
+/// Returns placeholder bytes for a data hashed manifest, pre-formatted for
+/// insertion into an asset of the given format
+///
+/// The caller writes the placeholder into the output asset, hashes the
+/// result with the placeholder region excluded, and patches in the signed
+/// manifest from c2pa_sign_data_hashed_manifest, which is the same size.
+/// The placeholder length is returned via the len parameter.
+/// reserve_size must be at least the reserve size of the signer that will
+/// sign the manifest.
+///
+/// # Errors
+/// Returns NULL if there were errors, otherwise returns the placeholder bytes
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// Reads from null terminated C strings
+/// The returned value MUST be released by calling c2pa_release_buffer
+/// and it is no longer valid after that call.
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_manifest_data_hash_placeholder(
+    manifest_json: *const c_char,
+    reserve_size: usize,
+    format: *const c_char,
+    len: *mut usize,
+) -> *mut u8 {
+    let manifest_json = from_cstr_null_check!(manifest_json);
+    let format = from_cstr_null_check!(format);
+
+    let result = data_hash_placeholder(&manifest_json, reserve_size, &format);
+
+    match result {
+        Ok(placeholder) => to_c_buffer(placeholder, len),
+        Err(e) => {
+            e.set_last();
+            std::ptr::null_mut()
+        }
+    }
+}
+
+/// Signs a manifest over a caller supplied data hash and returns the signed
+/// manifest bytes, pre-formatted to replace the placeholder in the asset
+///
+/// data_hash_json holds a DataHash whose exclusions cover the placeholder
+/// region, e.g. {"exclusions": [{"start": 20, "length": 64000}],
+/// "name": "jumbf manifest", "alg": "sha256", "hash": [], "pad": []}
+/// A digest the caller has already computed over the non-excluded ranges
+/// may be supplied in the hash field as a hex string and is used as is, so
+/// the asset is not hashed again. If the hash is empty and asset_path names
+/// the composed asset, the hash is computed here over the non-excluded
+/// ranges with a pipeline that overlaps file reads with hashing (see
+/// c2pa_set_hash_chunk_size). The manifest length is returned via the len
+/// parameter.
+///
+/// # Errors
+/// Returns NULL if there were errors, otherwise returns the manifest bytes
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// Reads from null terminated C strings
+/// The returned value MUST be released by calling c2pa_release_buffer
+/// and it is no longer valid after that call.
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_sign_data_hashed_manifest(
+    manifest_json: *const c_char,
+    signer: *const C2paSigner,
+    format: *const c_char,
+    data_hash_json: *const c_char,
+    asset_path: *const c_char,
+    len: *mut usize,
+) -> *mut u8 {
+    if signer.is_null() {
+        Error::set_last(Error::NullParameter("signer".to_string()));
+        return std::ptr::null_mut();
+    }
+    let manifest_json = from_cstr_null_check!(manifest_json);
+    let format = from_cstr_null_check!(format);
+    let data_hash_json = from_cstr_null_check!(data_hash_json);
+    let asset_path = from_cstr_option!(asset_path);
+
+    let result = sign_data_hashed_manifest(
+        &manifest_json,
+        &*(*signer).signer,
+        &format,
+        &data_hash_json,
+        asset_path.as_deref(),
+    );
+
+    match result {
+        Ok(manifest) => to_c_buffer(manifest, len),
+        Err(e) => {
+            e.set_last();
+            std::ptr::null_mut()
+        }
+    }
+}
+
+/// Signs a manifest for the file at source_path without rewriting the asset
+/// and returns the signed manifest store bytes
+///
+/// The asset is only read, to hash its bytes, so signing a large master does
+/// not copy it. With a NULL remote_url the manifest is written as a detached
+/// .c2pa sidecar, to sidecar_path or next to the asset when sidecar_path is
+/// NULL, where readers find it when the asset has no embedded manifest.
+/// With a remote_url the claim records that url as the manifest location and
+/// the returned bytes are for the caller to host there; a sidecar is then
+/// only written if sidecar_path is also given. The manifest length is
+/// returned via the len parameter.
+///
+/// # Errors
+/// Returns NULL if there were errors, otherwise returns the manifest bytes
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// Reads from null terminated C strings
+/// The signer handle must be valid and not freed during the call
+/// The returned value MUST be released by calling c2pa_release_buffer
+/// and it is no longer valid after that call.
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_sign_file_detached(
+    source_path: *const c_char,
+    manifest: *const c_char,
+    signer: *const C2paSigner,
+    sidecar_path: *const c_char,
+    remote_url: *const c_char,
+    len: *mut usize,
+) -> *mut u8 {
+    if signer.is_null() {
+        Error::set_last(Error::NullParameter("signer".to_string()));
+        return std::ptr::null_mut();
+    }
+    let source_path = from_cstr_null_check!(source_path);
+    let manifest = from_cstr_null_check!(manifest);
+    let sidecar_path = from_cstr_option!(sidecar_path);
+    let remote_url = from_cstr_option!(remote_url);
+
+    let result = sign_file_detached(
+        &source_path,
+        &manifest,
+        &*(*signer).signer,
+        sidecar_path.as_deref(),
+        remote_url.as_deref(),
+    );
+
+    match result {
+        Ok(manifest_bytes) => to_c_buffer(manifest_bytes, len),
+        Err(e) => {
+            e.set_last();
+            std::ptr::null_mut()
+        }
+    }
+}
+
+/// Frees a signer handle created by c2pa_signer_create
+///
+/// # Safety
+/// The handle can only be freed once and is invalid after this call
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_signer_free(signer: *mut C2paSigner) {
+    if signer.is_null() {
+        return;
+    }
+    let _release = Box::from_raw(signer);
+}
+
+/// A long lived signing session over an internal worker pool
+/// (see c2pa_signer_session_create)
+#[cfg(feature = "signing")]
+pub struct C2paSignerSession {
+    session: SignerSession,
+}
+
+/// Creates a signing session from the signer_info fields
+///
+/// Each worker thread parses its own signer when the session is created, so
+/// the key and certificate chain are warm before the first request. Queued
+/// requests go to whichever worker frees up first, so hashing, signing and
+/// timestamp authority round trips for different assets overlap.
+/// thread_count of 0 uses the available parallelism of the host
+///
+/// # Errors
+/// Returns NULL if there were errors, otherwise returns a session handle
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// Reads from null terminated C strings
+/// The returned value MUST be released by calling c2pa_signer_session_free
+/// and it is no longer valid after that call.
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_signer_session_create(
+    signer_info: &C2paSignerInfo,
+    thread_count: usize,
+) -> *mut C2paSignerSession {
+    let signer_info = SignerInfo {
+        alg: from_cstr_null_check!(signer_info.alg),
+        sign_cert: from_cstr_null_check!(signer_info.sign_cert).into_bytes(),
+        private_key: from_cstr_null_check!(signer_info.private_key).into_bytes(),
+        ta_url: from_cstr_option!(signer_info.ta_url),
+    };
+
+    match SignerSession::new(&signer_info, thread_count) {
+        Ok(session) => Box::into_raw(Box::new(C2paSignerSession { session })),
+        Err(e) => {
+            e.set_last();
+            std::ptr::null_mut()
+        }
+    }
+}
+
+/// Queues a file to sign on the session and returns immediately
+///
+/// The callback, if not NULL, is called once from a worker thread when the
+/// request completes, with the error message or NULL on success
+///
+/// # Errors
+/// Returns -1 if the request could not be queued, otherwise 0; per request
+/// errors are reported through the callback
+///
+/// # Safety
+/// Reads from null terminated C strings
+/// The session must be a valid handle from c2pa_signer_session_create
+/// The callback may be invoked from another thread and must be thread safe;
+/// its error pointer is only valid during the callback
+/// The context must remain valid until the callback has run
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_signer_session_sign_file(
+    session: *const C2paSignerSession,
+    source_path: *const c_char,
+    dest_path: *const c_char,
+    manifest: *const c_char,
+    callback: Option<unsafe extern "C" fn(error: *const c_char, context: *mut c_void)>,
+    context: *mut c_void,
+) -> std::os::raw::c_int {
+    if session.is_null() {
+        Error::set_last(Error::NullParameter("session".to_string()));
+        return -1;
+    }
+    let source_path = from_cstr_size_check!(source_path);
+    let dest_path = from_cstr_size_check!(dest_path);
+    let manifest = from_cstr_size_check!(manifest);
+
+    let batch_context = BatchContext(context);
+    let on_complete: OnSignComplete = Box::new(move |error: Option<&Error>| {
+        if let Some(callback) = callback {
+            let context = &batch_context;
+            match error {
+                Some(error) => {
+                    if let Ok(message) = CString::new(error.to_string()) {
+                        callback(message.as_ptr(), context.0);
+                    }
+                }
+                None => callback(std::ptr::null(), context.0),
+            }
+        }
+    });
+    match (*session)
+        .session
+        .submit(&source_path, &dest_path, &manifest, on_complete)
+    {
+        Ok(()) => 0,
+        Err(e) => {
+            e.set_last();
+            -1
+        }
+    }
+}
+
+/// Blocks until every queued request on the session has completed
+///
+/// Returns the number of files signed successfully since the session was
+/// created
+///
+/// # Safety
+/// The session must be a valid handle from c2pa_signer_session_create
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_signer_session_wait(session: *const C2paSignerSession) -> i64 {
+    if session.is_null() {
+        Error::set_last(Error::NullParameter("session".to_string()));
+        return -1;
+    }
+    (*session).session.wait() as i64
+}
+
+/// Frees a session handle created by c2pa_signer_session_create
+///
+/// Waits for any queued requests to drain before returning
+///
+/// # Safety
+/// The handle can only be freed once and is invalid after this call
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_signer_session_free(session: *mut C2paSignerSession) {
+    if session.is_null() {
+        return;
+    }
+    let _release = Box::from_raw(session);
+}
+
+/// Add a signed manifest to the file at path using auth_token
+/// If cloud is true, upload the manifest to the cloud
+///
+/// # Errors
+/// Returns an error field if there were errors
+///
+/// # Safety
+/// Reads from null terminated C strings
+/// The returned value MUST be released by calling release_string
+/// and it is no longer valid after that call.
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_sign_file(
+    source_path: *const c_char,
+    dest_path: *const c_char,
+    manifest: *const c_char,
+    signer_info: &C2paSignerInfo,
+    data_dir: *const c_char,
+) -> *mut c_char {
+    // convert C pointers into Rust
+    let source_path = from_cstr_null_check!(source_path);
+    let dest_path = from_cstr_null_check!(dest_path);
+    let manifest = from_cstr_null_check!(manifest);
+    let data_dir = from_cstr_option!(data_dir);
+
+    let signer_info = SignerInfo {
+        alg: from_cstr_null_check!(signer_info.alg),
+        sign_cert: from_cstr_null_check!(signer_info.sign_cert).into_bytes(),
+        private_key: from_cstr_null_check!(signer_info.private_key).into_bytes(),
+        ta_url: from_cstr_option!(signer_info.ta_url),
+    };
+    // Read manifest from JSON and then sign and write it
+    let result = sign_file(&source_path, &dest_path, &manifest, &signer_info, data_dir);
+
+    match result {
+        Ok(_c2pa_data) => to_c_string("".to_string()),
+        Err(e) => {
+            e.set_last();
+            std::ptr::null_mut()
+        }
+    }
+}
+
+/// Add a signed manifest to an asset in memory and return the signed asset
+/// The format must be a supported mime type or extension (e.g. "image/jpeg" or "jpg")
+/// The length of the signed asset is returned via signed_len
+///
+/// # Errors
+/// Returns NULL if there were errors, otherwise returns the signed asset bytes
+/// The error string can be retrieved by calling c2pa_error
+///
+/// # Safety
+/// Reads len bytes from the data pointer, which must remain valid for the call
+/// The returned value MUST be released by calling release_buffer
+/// and it is no longer valid after that call.
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_sign_buffer(
+    data: *const u8,
+    len: usize,
+    format: *const c_char,
+    manifest: *const c_char,
+    signer_info: &C2paSignerInfo,
+    signed_len: *mut usize,
+) -> *mut u8 {
+    if data.is_null() {
+        Error::set_last(Error::NullParameter("data".to_string()));
+        return std::ptr::null_mut();
+    }
+    let format = from_cstr_null_check!(format);
+    let manifest = from_cstr_null_check!(manifest);
+    let data = std::slice::from_raw_parts(data, len);
+
+    let signer_info = SignerInfo {
+        alg: from_cstr_null_check!(signer_info.alg),
+        sign_cert: from_cstr_null_check!(signer_info.sign_cert).into_bytes(),
+        private_key: from_cstr_null_check!(signer_info.private_key).into_bytes(),
+        ta_url: from_cstr_option!(signer_info.ta_url),
+    };
+    // Read manifest from JSON and then sign the asset in memory
+    let result = sign_buffer(&format, data, &manifest, &signer_info);
+
+    match result {
+        Ok(signed) => to_c_buffer(signed, signed_len),
+        Err(e) => {
+            e.set_last();
+            std::ptr::null_mut()
+        }
+    }
+}
+
+// Wrapper making the caller's context pointer shareable across worker threads.
+// The caller is responsible for making the callback and context thread safe.
+struct BatchContext(*mut c_void);
+unsafe impl Send for BatchContext {}
+unsafe impl Sync for BatchContext {}
+
+/// Reads a batch of files over an internal worker pool
+///
+/// Workers pull paths from a shared queue so fast and slow assets balance
+/// across the pool, keeping I/O and validation running on all cores from a
+/// single process. No binary resources are written.
+///
+/// thread_count of 0 uses the available parallelism of the host.
+/// The callback is called once per item, from a worker thread, with the item
+/// index and either the ManifestStore JSON or the error message for that
+/// item; exactly one of the two is non NULL. Both pointers are only valid
+/// for the duration of the call. The callback and context must be safe to
+/// use from multiple threads at once.
+///
+/// # Errors
+/// Returns the number of files read successfully, or -1 if the batch could
+/// not be started. Per item errors are reported through the callback.
+///
+/// # Safety
+/// Reads count pointers from paths, each a null terminated C string
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_read_files(
+    paths: *const *const c_char,
+    count: usize,
+    thread_count: usize,
+    callback: Option<
+        unsafe extern "C" fn(
+            index: usize,
+            json: *const c_char,
+            error: *const c_char,
+            context: *mut c_void,
+        ),
+    >,
+    context: *mut c_void,
+) -> i64 {
+    if paths.is_null() {
+        Error::set_last(Error::NullParameter("paths".to_string()));
+        return -1;
+    }
+    let mut path_vec = Vec::with_capacity(count);
+    for i in 0..count {
+        let path = *paths.add(i);
+        if path.is_null() {
+            Error::set_last(Error::NullParameter(format!("path {}", i)));
+            return -1;
+        }
+        path_vec.push(from_c_str(path));
+    }
+
+    let batch_context = BatchContext(context);
+    let result = read_files(&path_vec, thread_count, |index, item| {
+        if let Some(callback) = callback {
+            let context = &batch_context;
+            match item {
+                Ok(report) => {
+                    if let Ok(json) = CString::new(report) {
+                        callback(index, json.as_ptr(), std::ptr::null(), context.0);
+                    }
+                }
+                Err(e) => {
+                    if let Ok(message) = CString::new(e.to_string()) {
+                        callback(index, std::ptr::null(), message.as_ptr(), context.0);
+                    }
+                }
+            }
+        }
+    });
+
+    match result {
+        Ok(succeeded) => succeeded as i64,
+        Err(e) => {
+            e.set_last();
+            -1
+        }
+    }
+}
+
+/// Sign a batch of files over an internal worker pool using one manifest and signer_info
+/// source_paths and dest_paths are parallel arrays of count paths
+/// thread_count of 0 uses all available cores
+/// The callback, if not NULL, is called once per item from a worker thread
+/// with the item index, an error message or NULL on success, and the context;
+/// it must be thread safe and the error pointer is only valid during the callback
+///
+/// # Errors
+/// Returns -1 if the batch could not be started; per-item errors are reported
+/// through the callback since worker errors cannot reach this thread's c2pa_error
+///
+/// # Safety
+/// Reads from arrays of null terminated C strings, which must hold count entries
+/// The context must remain valid until this call returns
+#[cfg(feature = "signing")]
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_sign_files_batch(
+    source_paths: *const *const c_char,
+    dest_paths: *const *const c_char,
+    count: usize,
+    manifest: *const c_char,
+    signer_info: &C2paSignerInfo,
+    thread_count: usize,
+    callback: Option<
+        unsafe extern "C" fn(index: usize, error: *const c_char, context: *mut c_void),
+    >,
+    context: *mut c_void,
+) -> i64 {
+    if source_paths.is_null() || dest_paths.is_null() {
+        Error::set_last(Error::NullParameter("paths".to_string()));
+        return -1;
+    }
+    let manifest = if manifest.is_null() {
+        Error::set_last(Error::NullParameter("manifest".to_string()));
+        return -1;
+    } else {
+        from_c_str(manifest)
+    };
+    let mut sources = Vec::with_capacity(count);
+    let mut dests = Vec::with_capacity(count);
+    for i in 0..count {
+        let source = *source_paths.add(i);
+        let dest = *dest_paths.add(i);
+        if source.is_null() || dest.is_null() {
+            Error::set_last(Error::NullParameter(format!("path {}", i)));
+            return -1;
+        }
+        sources.push(from_c_str(source));
+        dests.push(from_c_str(dest));
+    }
+    let signer_info = SignerInfo {
+        alg: if signer_info.alg.is_null() {
+            Error::set_last(Error::NullParameter("signer_info.alg".to_string()));
+            return -1;
+        } else {
+            from_c_str(signer_info.alg)
+        },
+        sign_cert: if signer_info.sign_cert.is_null() {
+            Error::set_last(Error::NullParameter("signer_info.sign_cert".to_string()));
+            return -1;
+        } else {
+            from_c_str(signer_info.sign_cert).into_bytes()
+        },
+        private_key: if signer_info.private_key.is_null() {
+            Error::set_last(Error::NullParameter("signer_info.private_key".to_string()));
+            return -1;
+        } else {
+            from_c_str(signer_info.private_key).into_bytes()
+        },
+        ta_url: from_cstr_option!(signer_info.ta_url),
+    };
+
+    let batch_context = BatchContext(context);
+    let result = sign_files_batch(
+        &sources,
+        &dests,
+        &manifest,
+        &signer_info,
+        thread_count,
+        |index, error| {
+            if let Some(callback) = callback {
+                let context = &batch_context;
+                match error {
+                    Some(e) => {
+                        if let Ok(message) = CString::new(e.to_string()) {
+                            callback(index, message.as_ptr(), context.0);
+                        }
+                    }
+                    None => callback(index, std::ptr::null(), context.0),
+                }
+            }
+        },
+    );
+
+    match result {
+        Ok(succeeded) => succeeded as i64,
+        Err(e) => {
+            e.set_last();
+            -1
+        }
+    }
+}
+
+/// Releases a string allocated by Rust
+///
+/// # Safety
+/// Reads from null terminated C strings
+/// The string must not have been modified in C
+/// can only be released once and is invalid after this call
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_release_string(s: *mut c_char) {
+    if s.is_null() {
         return;
     }
     let _release = CString::from_raw(s);
 }
+
+/// Releases a buffer allocated by Rust
+///
+/// # Safety
+/// The buffer must have been allocated by this library with the given length
+/// can only be released once and is invalid after this call
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_release_buffer(buf: *mut u8, len: usize) {
+    if buf.is_null() {
+        return;
+    }
+    let _release = Vec::from_raw_parts(buf, len, len);
+}
@@ -0,0 +1,173 @@
+// Copyright 2023 Adobe. All rights reserved.
+// This file is licensed to you under the Apache License,
+// Version 2.0 (http://www.apache.org/licenses/LICENSE-2.0)
+// or the MIT license (http://opensource.org/licenses/MIT),
+// at your option.
+// Unless required by applicable law or agreed to in writing,
+// this software is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR REPRESENTATIONS OF ANY KIND, either express or
+// implied. See the LICENSE-MIT and LICENSE-APACHE files for the
+// specific language governing permissions and limitations under
+// each license.
+
+use std::io::{Read, Seek, SeekFrom, Write};
+
+/// An opaque context passed through to the stream callbacks
+///
+/// The C caller owns the context and is responsible for its lifetime.
+#[repr(C)]
+#[derive(Debug)]
+pub struct StreamContext {
+    _priv: (),
+}
+
+/// Defines the seek modes for the seek callback, matching SEEK_SET, SEEK_CUR and SEEK_END
+#[repr(C)]
+#[derive(Debug)]
+pub enum C2paSeekMode {
+    Start = 0,
+    Current = 1,
+    End = 2,
+}
+
+/// Reads up to len bytes into data, returning the number of bytes read or a negative value on error
+pub type ReadCallback =
+    unsafe extern "C" fn(context: *mut StreamContext, data: *mut u8, len: usize) -> isize;
+
+/// Seeks to offset using the given mode, returning the new position or a negative value on error
+pub type SeekCallback =
+    unsafe extern "C" fn(context: *mut StreamContext, offset: i64, mode: C2paSeekMode) -> i64;
+
+/// Writes len bytes from data, returning the number of bytes written or a negative value on error
+pub type WriteCallback =
+    unsafe extern "C" fn(context: *mut StreamContext, data: *const u8, len: usize) -> isize;
+
+/// Flushes any buffered writes, returning zero or a negative value on error
+pub type FlushCallback = unsafe extern "C" fn(context: *mut StreamContext) -> i64;
+
+#[repr(C)]
+/// A C2paStream is a Rust Read/Write/Seek stream that can be created in C
+/// from a context pointer and a set of callbacks
+///
+/// This allows the library to read and write assets held by the caller
+/// (for example in object storage) without any temporary files.
+pub struct C2paStream {
+    context: *mut StreamContext,
+    reader: ReadCallback,
+    seeker: SeekCallback,
+    writer: WriteCallback,
+    flusher: FlushCallback,
+}
+
+impl C2paStream {
+    /// Creates a new C2paStream from context and callbacks
+    ///
+    /// # Safety
+    /// The context must be valid for the lifetime of the stream
+    /// The callbacks must be valid C functions honoring the callback contracts
+    pub unsafe fn new(
+        context: *mut StreamContext,
+        reader: ReadCallback,
+        seeker: SeekCallback,
+        writer: WriteCallback,
+        flusher: FlushCallback,
+    ) -> Self {
+        Self {
+            context,
+            reader,
+            seeker,
+            writer,
+            flusher,
+        }
+    }
+}
+
+impl Read for C2paStream {
+    fn read(&mut self, buf: &mut [u8]) -> std::io::Result<usize> {
+        let bytes_read = unsafe { (self.reader)(self.context, buf.as_mut_ptr(), buf.len()) };
+        if bytes_read < 0 {
+            return Err(std::io::Error::last_os_error());
+        }
+        Ok(bytes_read as usize)
+    }
+}
+
+impl Seek for C2paStream {
+    fn seek(&mut self, pos: SeekFrom) -> std::io::Result<u64> {
+        let (offset, mode) = match pos {
+            SeekFrom::Start(offset) => (offset as i64, C2paSeekMode::Start),
+            SeekFrom::Current(offset) => (offset, C2paSeekMode::Current),
+            SeekFrom::End(offset) => (offset, C2paSeekMode::End),
+        };
+        let new_pos = unsafe { (self.seeker)(self.context, offset, mode) };
+        if new_pos < 0 {
+            return Err(std::io::Error::last_os_error());
+        }
+        Ok(new_pos as u64)
+    }
+}
+
+impl Write for C2paStream {
+    fn write(&mut self, buf: &[u8]) -> std::io::Result<usize> {
+        let bytes_written = unsafe { (self.writer)(self.context, buf.as_ptr(), buf.len()) };
+        if bytes_written < 0 {
+            return Err(std::io::Error::last_os_error());
+        }
+        Ok(bytes_written as usize)
+    }
+
+    fn flush(&mut self) -> std::io::Result<()> {
+        let err = unsafe { (self.flusher)(self.context) };
+        if err < 0 {
+            return Err(std::io::Error::last_os_error());
+        }
+        Ok(())
+    }
+}
+
+impl c2pa::CAIRead for C2paStream {}
+
+impl c2pa::CAIReadWrite for C2paStream {}
+
+// The C caller is responsible for ensuring the callbacks are thread safe
+unsafe impl Send for C2paStream {}
+
+/// Creates a new C2paStream from context with callbacks
+///
+/// This allows implementing streams in other languages
+///
+/// # Arguments
+/// * `context` - a pointer to a StreamContext
+/// * `reader` - a ReadCallback to read from the stream
+/// * `seeker` - a SeekCallback to seek in the stream
+/// * `writer` - a WriteCallback to write to the stream
+/// * `flusher` - a FlushCallback to flush the stream
+///
+/// # Safety
+/// The context must remain valid for the lifetime of the C2paStream
+/// The returned value MUST be released by calling c2pa_release_stream
+/// and it is no longer valid after that call.
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_create_stream(
+    context: *mut StreamContext,
+    reader: ReadCallback,
+    seeker: SeekCallback,
+    writer: WriteCallback,
+    flusher: FlushCallback,
+) -> *mut C2paStream {
+    Box::into_raw(Box::new(C2paStream::new(
+        context, reader, seeker, writer, flusher,
+    )))
+}
+
+/// Releases a C2paStream allocated by Rust
+///
+/// # Safety
+/// can only be released once and is invalid after this call
+#[no_mangle]
+pub unsafe extern "C" fn c2pa_release_stream(stream: *mut C2paStream) {
+    if stream.is_null() {
+        return;
+    }
+    let _release = Box::from_raw(stream);
+}
@@ -17,7 +17,35 @@ pub type Result<T> = std::result::Result<T, Error>;
 
 // LAST_ERROR handling borrowed from Copyright (c) 2018 Michael Bryan
 thread_local! {
-    static LAST_ERROR: RefCell<Option<Error>> = RefCell::new(None);
+    static LAST_ERROR: RefCell<Option<Error>> = const { RefCell::new(None) };
+}
+
+/// Stable numeric codes identifying each Error variant over the C API
+///
+/// These values are published in c2pa.h and must never be renumbered,
+/// only appended to.
+#[repr(C)]
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+// the common prefix is deliberate; these names are published C identifiers
+#[allow(clippy::enum_variant_names)]
+pub enum C2paErrorCode {
+    C2paErrorNone = 0,
+    C2paErrorAssertion = 1,
+    C2paErrorAssertionNotFound = 2,
+    C2paErrorDecoding = 3,
+    C2paErrorEncoding = 4,
+    C2paErrorFileNotFound = 5,
+    C2paErrorIo = 6,
+    C2paErrorJson = 7,
+    C2paErrorManifest = 8,
+    C2paErrorManifestNotFound = 9,
+    C2paErrorNotSupported = 10,
+    C2paErrorOther = 11,
+    C2paErrorNullParameter = 12,
+    C2paErrorRemoteManifest = 13,
+    C2paErrorResourceNotFound = 14,
+    C2paErrorSignature = 15,
+    C2paErrorVerify = 16,
 }
 
 #[derive(Error, Debug)]
@@ -107,12 +135,46 @@ impl Error {
             FileNotFound(_) => Self::FileNotFound(err_str),
             UnsupportedType => Self::NotSupported(err_str),
             ClaimVerification(_) | InvalidClaim(_) | JumbfParseError(_) => Self::Verify(err_str),
-            #[cfg(feature = "add_thumbnails")]
-            ImageError => Self::ImageError(err_str),
+            #[cfg(feature = "thumbnails")]
+            ImageError(_) => Self::Encoding(err_str),
             _ => Self::Other(err_str),
         }
     }
 
+    /// Returns the numeric code for this error
+    pub fn code(&self) -> C2paErrorCode {
+        use C2paErrorCode::*;
+        match self {
+            Self::Assertion(_) => C2paErrorAssertion,
+            Self::AssertionNotFound(_) => C2paErrorAssertionNotFound,
+            Self::Decoding(_) => C2paErrorDecoding,
+            Self::Encoding(_) => C2paErrorEncoding,
+            Self::FileNotFound(_) => C2paErrorFileNotFound,
+            Self::Io(_) => C2paErrorIo,
+            Self::Json(_) => C2paErrorJson,
+            Self::Manifest(_) => C2paErrorManifest,
+            Self::ManifestNotFound(_) => C2paErrorManifestNotFound,
+            Self::NotSupported(_) => C2paErrorNotSupported,
+            Self::Other(_) => C2paErrorOther,
+            Self::NullParameter(_) => C2paErrorNullParameter,
+            Self::RemoteManifest(_) => C2paErrorRemoteManifest,
+            Self::ResourceNotFound(_) => C2paErrorResourceNotFound,
+            Self::Signature(_) => C2paErrorSignature,
+            Self::Verify(_) => C2paErrorVerify,
+        }
+    }
+
+    /// Returns the numeric code of the last error without formatting
+    /// or allocating, or C2paErrorNone if no error has occurred
+    pub fn last_code() -> C2paErrorCode {
+        LAST_ERROR.with(|prev| {
+            prev.borrow()
+                .as_ref()
+                .map(|e| e.code())
+                .unwrap_or(C2paErrorCode::C2paErrorNone)
+        })
+    }
+
     /// Returns the last error as String
     pub fn last_message() -> Option<String> {
         LAST_ERROR.with(|prev| prev.borrow().as_ref().map(|e| e.to_string()))
@@ -128,3 +190,17 @@ impl Error {
         LAST_ERROR.with(|prev| prev.borrow_mut().take())
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_error_codes() {
+        Error::take_last();
+        assert_eq!(Error::last_code(), C2paErrorCode::C2paErrorNone);
+        Error::ManifestNotFound("test".to_string()).set_last();
+        assert_eq!(Error::last_code(), C2paErrorCode::C2paErrorManifestNotFound);
+        Error::take_last();
+    }
+}
@@ -10,9 +10,67 @@
 // specific language governing permissions and limitations under
 // each license.
 
-use c2pa::{Ingredient, Manifest, ManifestStore};
+#[cfg(feature = "signing")]
+use c2pa::{assertions::DataHash, CAIReadWrite, HashRange, Manifest, Signer};
+use c2pa::{CAIRead, DefaultOptions, Ingredient, IngredientOptions, ManifestStore};
 
-use crate::{Error, Result, SignerInfo};
+#[cfg(feature = "signing")]
+use crate::SignerInfo;
+use crate::{
+    trace::{finish_span, C2paTraceStage, TraceSpan},
+    Error, Result,
+};
+
+/// Read flag to skip writing thumbnails and other binary resources to the data_dir
+pub const C2PA_READ_SKIP_RESOURCES: u32 = 1;
+/// Read flag to skip generating a thumbnail for ingredients that do not carry one
+pub const C2PA_READ_SKIP_THUMBNAILS: u32 = 2;
+
+/// Sign flag declaring the source asset is known to be unsigned, skipping
+/// the parent manifest detection pass over the source
+#[cfg(feature = "signing")]
+pub const C2PA_SIGN_SKIP_PARENT_CHECK: u32 = 1;
+
+// When enabled, file based manifest reads parse a private memory mapping of
+// the asset instead of going through buffered file I/O
+static MMAP_READ: std::sync::atomic::AtomicBool = std::sync::atomic::AtomicBool::new(false);
+
+/// Enables or disables memory mapped reads for the file based read paths.
+///
+/// While enabled, the file based manifest readers map the asset into memory
+/// and parse it in place: locating the manifest store only faults in the
+/// pages it touches, and repeated scans over large trees share the page
+/// cache instead of copying every byte through read syscalls. Off by
+/// default. Assets without a file extension fall back to buffered reads.
+pub fn set_mmap_read(enabled: bool) {
+    MMAP_READ.store(enabled, std::sync::atomic::Ordering::Relaxed);
+}
+
+// Loads the manifest store at path, through a memory mapping when mmap reads
+// are enabled and through the sdk's buffered file reader otherwise. The
+// stream reader needs a format, which is taken from the file extension.
+fn manifest_store_from_file(path: &str) -> Result<ManifestStore> {
+    if MMAP_READ.load(std::sync::atomic::Ordering::Relaxed) {
+        let format = std::path::Path::new(path)
+            .extension()
+            .and_then(|ext| ext.to_str())
+            .map(str::to_lowercase);
+        if let Some(format) = format {
+            let file = std::fs::File::open(path).map_err(|e| Error::Io(e.to_string()))?;
+            // Safety: the mapping is private and read only; a concurrent
+            // writer truncating the file is undefined here, just as it is
+            // for the buffered reader's interleaved reads
+            let map = unsafe { memmap2::Mmap::map(&file) }.map_err(|e| Error::Io(e.to_string()))?;
+            // locating the store jumps between box headers, but the bulk of
+            // the work is verification hashing the asset front to back
+            let _ = map.advise(memmap2::Advice::Sequential);
+            let mut stream = std::io::Cursor::new(&map[..]);
+            return ManifestStore::from_stream(&format, &mut stream, true)
+                .map_err(Error::from_c2pa_error);
+        }
+    }
+    ManifestStore::from_file(path).map_err(Error::from_c2pa_error)
+}
 
 /// Returns ManifestStore JSON string from a file path.
 ///
@@ -20,10 +78,274 @@ use crate::{Error, Result, SignerInfo};
 /// Any Validation errors will be reported in the validation_status field.
 ///
 pub fn read_file(path: &str, data_dir: Option<String>) -> Result<String> {
-    Ok(match data_dir {
-        Some(dir) => ManifestStore::from_file_with_resources(path, &dir),
-        None => ManifestStore::from_file(path),
+    let span = TraceSpan::begin(C2paTraceStage::C2paTraceReadManifest);
+    let report = match data_dir {
+        Some(dir) => {
+            ManifestStore::from_file_with_resources(path, &dir).map_err(Error::from_c2pa_error)?
+        }
+        None => manifest_store_from_file(path)?,
+    }
+    .to_string();
+    finish_span(span, std::fs::metadata(path).map(|m| m.len()).unwrap_or(0));
+    Ok(report)
+}
+
+/// Returns ManifestStore JSON string from an asset held in memory.
+///
+/// The format must be a supported mime type or extension (e.g. "image/jpeg" or "jpg").
+/// Any Validation errors will be reported in the validation_status field.
+///
+pub fn read_buffer(format: &str, data: &[u8]) -> Result<String> {
+    let span = TraceSpan::begin(C2paTraceStage::C2paTraceReadManifest);
+    let report = ManifestStore::from_bytes(format, data, true)
+        .map_err(Error::from_c2pa_error)?
+        .to_string();
+    finish_span(span, data.len() as u64);
+    Ok(report)
+}
+
+/// Returns ManifestStore JSON string from a stream.
+///
+/// The format must be a supported mime type or extension (e.g. "image/jpeg" or "jpg").
+/// Any Validation errors will be reported in the validation_status field.
+///
+pub fn read_stream(format: &str, stream: &mut dyn CAIRead) -> Result<String> {
+    Ok(ManifestStore::from_stream(format, stream, true)
+        .map_err(Error::from_c2pa_error)?
+        .to_string())
+}
+
+/// Returns an Ingredient JSON string from a stream.
+///
+/// The format must be a supported mime type or extension (e.g. "image/jpeg" or "jpg").
+pub fn read_ingredient_stream(format: &str, stream: &mut dyn CAIRead) -> Result<String> {
+    Ok(Ingredient::from_stream(format, stream)
+        .map_err(Error::from_c2pa_error)?
+        .to_string())
+}
+
+/// Returns ManifestStore JSON string from a file path, honoring read flags.
+///
+/// With C2PA_READ_SKIP_RESOURCES set, no thumbnails or other binary
+/// resources are materialized even if a data_dir is provided, so callers
+/// that only need metadata avoid the resource serialization cost.
+pub fn read_file_with_flags(path: &str, data_dir: Option<String>, flags: u32) -> Result<String> {
+    let data_dir = if flags & C2PA_READ_SKIP_RESOURCES != 0 {
+        None
+    } else {
+        data_dir
+    };
+    read_file(path, data_dir)
+}
+
+// Streams serialized report JSON through to a writer while rewriting "hash"
+// byte arrays to base64 strings and omitting "pad" arrays, matching the
+// report read_file produces. Only the byte array being rewritten is ever
+// buffered, so memory stays bounded no matter how large the report is.
+struct ReportByteArrayFilter<'a> {
+    out: &'a mut dyn std::io::Write,
+    // the most recently emitted bytes, enough to recognize the key ahead of
+    // an array value
+    window: [u8; 8],
+    // Some while inside a matched array, holding the captured bytes and
+    // whether the key was "hash"
+    capture: Option<(Vec<u8>, bool)>,
+}
+
+impl<'a> ReportByteArrayFilter<'a> {
+    fn new(out: &'a mut dyn std::io::Write) -> Self {
+        Self {
+            out,
+            window: [0; 8],
+            capture: None,
+        }
+    }
+
+    fn window_ends(&self, tail: &[u8]) -> bool {
+        self.window[self.window.len() - tail.len()..] == *tail
+    }
+
+    fn emit_capture(&mut self, captured: Vec<u8>, is_hash: bool) -> std::io::Result<()> {
+        if is_hash {
+            // a "hash" key over something other than a byte array passes
+            // through unchanged
+            match serde_json::from_slice::<Vec<u8>>(&captured) {
+                Ok(bytes) => write!(self.out, "\"{}\"", base64::encode(&bytes)),
+                Err(_) => self.out.write_all(&captured),
+            }
+        } else {
+            self.out.write_all(b"\"<omitted>\"")
+        }
+    }
+}
+
+impl std::io::Write for ReportByteArrayFilter<'_> {
+    fn write(&mut self, buf: &[u8]) -> std::io::Result<usize> {
+        let mut run = 0;
+        for (at, &byte) in buf.iter().enumerate() {
+            if let Some((captured, _)) = self.capture.as_mut() {
+                captured.push(byte);
+                run = at + 1;
+                if byte == b']' {
+                    if let Some((captured, is_hash)) = self.capture.take() {
+                        self.emit_capture(captured, is_hash)?;
+                    }
+                }
+            } else if byte == b'['
+                && (self.window_ends(b"\"hash\": ") || self.window_ends(b"\"pad\": "))
+            {
+                self.out.write_all(&buf[run..at])?;
+                self.capture = Some((vec![byte], self.window_ends(b"\"hash\": ")));
+                run = at + 1;
+            } else {
+                self.window.rotate_left(1);
+                self.window[self.window.len() - 1] = byte;
+            }
+        }
+        if self.capture.is_none() {
+            self.out.write_all(&buf[run..])?;
+        }
+        Ok(buf.len())
+    }
+
+    fn flush(&mut self) -> std::io::Result<()> {
+        self.out.flush()
+    }
+}
+
+/// Writes the ManifestStore JSON report for a file path incrementally to a
+/// writer.
+///
+/// The report is identical to the one read_file returns, but it is
+/// serialized straight through to the writer instead of materializing one
+/// string, so peak memory stays bounded no matter how many ingredients the
+/// store carries. No binary resources are written.
+pub fn read_file_stream(path: &str, writer: &mut dyn std::io::Write) -> Result<()> {
+    use serde::Serialize;
+
+    let span = TraceSpan::begin(C2paTraceStage::C2paTraceReadManifest);
+    let store = manifest_store_from_file(path)?;
+    let mut filter = ReportByteArrayFilter::new(writer);
+    let mut serializer = serde_json::Serializer::pretty(&mut filter);
+    store
+        .serialize(&mut serializer)
+        .map_err(|e| Error::Json(e.to_string()))?;
+    finish_span(span, std::fs::metadata(path).map(|m| m.len()).unwrap_or(0));
+    Ok(())
+}
+
+/// Returns a JSON object holding only the selected fields of the active manifest.
+///
+/// labels is a comma separated list of assertion labels (e.g.
+/// "c2pa.training-mining") and/or the special fields "title",
+/// "claim_generator" and "validation_status". Only the requested values are
+/// serialized, so callers do not pay to serialize and re-parse whole
+/// manifest stores just to inspect one assertion.
+pub fn read_file_selected(path: &str, labels: &str) -> Result<String> {
+    let store = manifest_store_from_file(path)?;
+    let manifest = store
+        .get_active()
+        .ok_or_else(|| Error::ManifestNotFound("no active manifest".to_string()))?;
+
+    let mut report = serde_json::Map::new();
+    for label in labels.split(',').map(str::trim).filter(|l| !l.is_empty()) {
+        let value = match label {
+            "title" => manifest.title().map(|t| serde_json::json!(t)),
+            "claim_generator" => Some(serde_json::json!(manifest.claim_generator())),
+            "validation_status" => store.validation_status().map(|s| serde_json::json!(s)),
+            label => manifest
+                .assertions()
+                .iter()
+                .find(|a| a.label() == label)
+                .and_then(|a| a.value().ok().cloned()),
+        };
+        if let Some(value) = value {
+            report.insert(label.to_string(), value);
+        }
+    }
+    serde_json::to_string_pretty(&report).map_err(|e| Error::Json(e.to_string()))
+}
+
+/// Returns true if the asset at path contains a C2PA manifest store.
+///
+/// Only the container box/segment headers are scanned for JUMBF data;
+/// the manifest store is not deserialized or validated, so this is much
+/// cheaper than read_file for assets with no C2PA data.
+pub fn has_manifest(path: &str) -> Result<bool> {
+    match c2pa::jumbf_io::load_jumbf_from_file(std::path::Path::new(path)) {
+        Ok(_) => Ok(true),
+        Err(c2pa::Error::JumbfNotFound) => Ok(false),
+        Err(e) => Err(Error::from_c2pa_error(e)),
+    }
+}
+
+/// Returns a ManifestStore report from a file path as compact CBOR.
+///
+/// The report has the same structure as the JSON from read_file but skips
+/// the JSON text round trip, which is faster to parse and ~40% smaller on
+/// the wire. No binary resources are written.
+pub fn read_file_cbor(path: &str) -> Result<Vec<u8>> {
+    let store = manifest_store_from_file(path)?;
+    serde_cbor::to_vec(&store).map_err(|e| Error::Encoding(e.to_string()))
+}
+
+/// Returns an Ingredient report from a file path as compact CBOR.
+///
+/// The report has the same structure as the JSON from read_ingredient_file
+/// but skips the JSON text round trip. No binary resources are written.
+pub fn read_ingredient_file_cbor(path: &str) -> Result<Vec<u8>> {
+    let ingredient = Ingredient::from_file(path).map_err(Error::from_c2pa_error)?;
+    serde_cbor::to_vec(&ingredient).map_err(|e| Error::Encoding(e.to_string()))
+}
+
+// Drives one of the c2pa async entry points to completion.
+//
+// The async variants exist for wasm; on native builds they never await a
+// pending future, so a bare poll loop with a no-op waker resolves them
+// without pulling an executor into the crate.
+fn block_on<F: std::future::Future>(future: F) -> Result<F::Output> {
+    use std::task::{Context, Poll, RawWaker, RawWakerVTable, Waker};
+
+    fn noop_raw_waker() -> RawWaker {
+        fn clone(_: *const ()) -> RawWaker {
+            noop_raw_waker()
+        }
+        fn noop(_: *const ()) {}
+        RawWaker::new(
+            std::ptr::null(),
+            &RawWakerVTable::new(clone, noop, noop, noop),
+        )
     }
+
+    let waker = unsafe { Waker::from_raw(noop_raw_waker()) };
+    let mut context = Context::from_waker(&waker);
+    let mut future = Box::pin(future);
+    // bounded so an unexpectedly pending future fails instead of spinning
+    for _ in 0..1000 {
+        if let Poll::Ready(output) = future.as_mut().poll(&mut context) {
+            return Ok(output);
+        }
+    }
+    Err(Error::NotSupported(
+        "async operation did not complete".to_string(),
+    ))
+}
+
+/// Returns a ManifestStore JSON string from a fragmented BMFF asset held in
+/// memory, e.g. one DASH/HLS media segment plus its init segment.
+///
+/// Only the two segments are read, so a player can validate fragments as
+/// they arrive instead of concatenating the stream into a monolithic file.
+/// The format must be a supported BMFF mime type or extension (e.g.
+/// "video/mp4" or "mp4"). Any validation errors will be reported in the
+/// validation_status field.
+pub fn read_fragment(format: &str, init_bytes: &[u8], fragment_bytes: &[u8]) -> Result<String> {
+    Ok(block_on(ManifestStore::from_fragment_bytes_async(
+        format,
+        init_bytes,
+        fragment_bytes,
+        true,
+    ))?
     .map_err(Error::from_c2pa_error)?
     .to_string())
 }
@@ -37,12 +359,154 @@ pub fn read_ingredient_file(path: &str, data_dir: &str) -> Result<String> {
         .to_string())
 }
 
+/// Returns an Ingredient JSON string from a file path, honoring read flags.
+///
+/// With C2PA_READ_SKIP_RESOURCES set, no thumbnail or c2pa data is written
+/// to data_dir. With C2PA_READ_SKIP_THUMBNAILS set, no thumbnail is decoded
+/// or generated for assets that do not already carry one, which skips the
+/// image decode/encode cost entirely.
+pub fn read_ingredient_file_with_flags(path: &str, data_dir: &str, flags: u32) -> Result<String> {
+    use std::path::{Path, PathBuf};
+
+    struct Options {
+        base: Option<PathBuf>,
+        make_thumbnail: bool,
+    }
+    impl IngredientOptions for Options {
+        fn thumbnail(&self, path: &Path) -> Option<(String, Vec<u8>)> {
+            if self.make_thumbnail {
+                DefaultOptions { base: None }.thumbnail(path)
+            } else {
+                None
+            }
+        }
+        fn base_path(&self) -> Option<&Path> {
+            self.base.as_deref()
+        }
+    }
+
+    let options = Options {
+        base: if flags & C2PA_READ_SKIP_RESOURCES != 0 {
+            None
+        } else {
+            Some(PathBuf::from(data_dir))
+        },
+        make_thumbnail: flags & C2PA_READ_SKIP_THUMBNAILS == 0,
+    };
+    Ok(
+        Ingredient::from_file_with_options(std::path::Path::new(path), &options)
+            .map_err(Error::from_c2pa_error)?
+            .to_string(),
+    )
+}
+
+/// Options controlling ingredient binary resource extraction.
+pub struct IngredientExtractOptions {
+    /// Combination of the C2PA_READ_* flags
+    pub flags: u32,
+    /// Longest edge in pixels for a thumbnail generated from the asset;
+    /// zero keeps the sdk default of 1024
+    pub max_thumbnail_dimension: u32,
+    /// Resources larger than this many bytes are not delivered; zero means
+    /// no cap
+    pub max_resource_bytes: u64,
+}
+
+// Generates a thumbnail capped to longest_edge pixels on its longest edge,
+// at the same jpeg quality the sdk uses for its generated thumbnails.
+#[cfg(feature = "thumbnails")]
+fn make_scaled_thumbnail(path: &std::path::Path, longest_edge: u32) -> Option<(String, Vec<u8>)> {
+    let mut img = image::open(path).ok()?;
+    if img.width() > longest_edge || img.height() > longest_edge {
+        img = img.thumbnail(longest_edge, longest_edge);
+    }
+    let mut cursor = std::io::Cursor::new(Vec::new());
+    img.write_to(&mut cursor, image::ImageOutputFormat::Jpeg(80))
+        .ok()?;
+    Some(("image/jpeg".to_string(), cursor.into_inner()))
+}
+
+// Builds without the thumbnails feature carry no image codecs and never
+// generate a thumbnail
+#[cfg(not(feature = "thumbnails"))]
+fn make_scaled_thumbnail(_path: &std::path::Path, _longest_edge: u32) -> Option<(String, Vec<u8>)> {
+    None
+}
+
+/// Callback receiving an extracted resource id and its bytes.
+pub type OnResource<'a> = &'a mut dyn FnMut(&str, &[u8]);
+
+/// Returns an Ingredient JSON string from a file path, delivering binary
+/// resources under the caller's extraction options.
+///
+/// Resources are built in memory and, when on_resource is given, handed to
+/// it as (resource id, bytes) so an ingest service can take just a small
+/// preview without any disk writes; otherwise they are written under
+/// data_dir like read_ingredient_file. Resources over max_resource_bytes
+/// are dropped in either case, and a generated thumbnail is downscaled to
+/// max_thumbnail_dimension pixels on its longest edge.
+pub fn read_ingredient_file_with_options(
+    path: &str,
+    data_dir: Option<&str>,
+    options: &IngredientExtractOptions,
+    mut on_resource: Option<OnResource>,
+) -> Result<String> {
+    struct Options {
+        make_thumbnail: bool,
+        longest_edge: u32,
+    }
+    impl IngredientOptions for Options {
+        fn thumbnail(&self, path: &std::path::Path) -> Option<(String, Vec<u8>)> {
+            if !self.make_thumbnail {
+                return None;
+            }
+            if self.longest_edge != 0 {
+                return make_scaled_thumbnail(path, self.longest_edge);
+            }
+            DefaultOptions { base: None }.thumbnail(path)
+        }
+    }
+
+    let ingredient_options = Options {
+        make_thumbnail: options.flags & C2PA_READ_SKIP_THUMBNAILS == 0,
+        longest_edge: options.max_thumbnail_dimension,
+    };
+    // no base path, so resources stay in the ingredient's memory store and
+    // the caps below also apply to resources extracted from the manifest
+    let ingredient =
+        Ingredient::from_file_with_options(std::path::Path::new(path), &ingredient_options)
+            .map_err(Error::from_c2pa_error)?;
+    if options.flags & C2PA_READ_SKIP_RESOURCES == 0 {
+        for (id, data) in ingredient.resources().resources() {
+            if options.max_resource_bytes != 0 && data.len() as u64 > options.max_resource_bytes {
+                continue;
+            }
+            match on_resource.as_mut() {
+                Some(on_resource) => on_resource(id, data),
+                None => {
+                    if let Some(dir) = data_dir {
+                        // mirror the sdk's resource layout of one file per id
+                        let dest = std::path::Path::new(dir).join(id);
+                        if let Some(parent) = dest.parent() {
+                            std::fs::create_dir_all(parent)
+                                .map_err(|e| Error::Io(e.to_string()))?;
+                        }
+                        std::fs::write(dest, data).map_err(|e| Error::Io(e.to_string()))?;
+                    }
+                }
+            }
+        }
+    }
+    Ok(ingredient.to_string())
+}
+
 /// Adds a manifest to the source file and writes the result to the destination file.
 /// Also returns the binary manifest data for optional cloud storage
 /// A manifest definition must be supplied
 /// Signer information must also be supplied
 ///
 /// Any file paths in the manifest will be read relative to the source file
+#[cfg(feature = "signing")]
 pub fn sign_file(
     source: &str,
     dest: &str,
@@ -50,8 +514,59 @@ pub fn sign_file(
     signer_info: &SignerInfo,
     data_dir: Option<String>,
 ) -> Result<Vec<u8>> {
-    let mut manifest = Manifest::from_json(manifest_json).map_err(Error::from_c2pa_error)?;
+    let signer = signer_info.signer()?;
+    sign_file_with_signer(source, dest, manifest_json, &*signer, data_dir)
+}
+
+/// Adds a manifest to the source file and writes the result to the destination file
+/// using an already constructed signer.
+///
+/// This avoids re-parsing the certificates and private key on every call.
+#[cfg(feature = "signing")]
+pub fn sign_file_with_signer(
+    source: &str,
+    dest: &str,
+    manifest_json: &str,
+    signer: &dyn Signer,
+    data_dir: Option<String>,
+) -> Result<Vec<u8>> {
+    sign_file_with_options(source, dest, manifest_json, signer, None, 0, data_dir)
+}
+
+/// Adds a manifest to the source file and writes the result to the destination file,
+/// with control over the parent ingredient.
+///
+/// If parent is provided it is used as the parent ingredient, eliminating the
+/// pass over the source that sign_file makes to detect one. With
+/// C2PA_SIGN_SKIP_PARENT_CHECK set and no parent, detection is skipped
+/// entirely for sources known to be unsigned.
+#[cfg(feature = "signing")]
+pub fn sign_file_with_options(
+    source: &str,
+    dest: &str,
+    manifest_json: &str,
+    signer: &dyn Signer,
+    parent: Option<Ingredient>,
+    flags: u32,
+    data_dir: Option<String>,
+) -> Result<Vec<u8>> {
+    let span = TraceSpan::begin(C2paTraceStage::C2paTraceManifestParse);
+    let manifest = Manifest::from_json(manifest_json).map_err(Error::from_c2pa_error)?;
+    finish_span(span, manifest_json.len() as u64);
+    embed_manifest_file(manifest, source, dest, signer, parent, flags, data_dir)
+}
 
+// Shared signing tail: applies the base path and parent, then embeds and signs.
+#[cfg(feature = "signing")]
+fn embed_manifest_file(
+    mut manifest: Manifest,
+    source: &str,
+    dest: &str,
+    signer: &dyn Signer,
+    parent: Option<Ingredient>,
+    flags: u32,
+    data_dir: Option<String>,
+) -> Result<Vec<u8>> {
     // if data_dir is provided, set the base path for the manifest
     if let Some(path) = data_dir {
         manifest
@@ -59,8 +574,12 @@ pub fn sign_file(
             .map_err(Error::from_c2pa_error)?;
     }
 
-    // If the source file has a manifest store, and no parent is specified, treat the source's manifest store as the parent.
-    if manifest.parent().is_none() {
+    if let Some(parent) = parent {
+        manifest
+            .set_parent(parent)
+            .map_err(Error::from_c2pa_error)?;
+    } else if manifest.parent().is_none() && flags & C2PA_SIGN_SKIP_PARENT_CHECK == 0 {
+        // If the source file has a manifest store, and no parent is specified, treat the source's manifest store as the parent.
         let source_ingredient = Ingredient::from_file(source).map_err(Error::from_c2pa_error)?;
         if source_ingredient.manifest_data().is_some() {
             manifest
@@ -69,12 +588,958 @@ pub fn sign_file(
         }
     }
 
+    let span = TraceSpan::begin(C2paTraceStage::C2paTraceEmbed);
+    let result = manifest
+        .embed(&source, &dest, signer)
+        .map_err(Error::from_c2pa_error)?;
+    finish_span(
+        span,
+        std::fs::metadata(source).map(|m| m.len()).unwrap_or(0),
+    );
+    Ok(result)
+}
+
+/// A manifest definition parsed and validated once, for reuse across many sign calls.
+///
+/// Instantiating from the template skips the JSON text parse that
+/// Manifest::from_json performs on every call; only a cheap value clone and
+/// an optional per-asset overlay merge remain in the signing loop.
+#[cfg(feature = "signing")]
+pub struct ManifestTemplate {
+    definition: serde_json::Value,
+}
+
+/// Parses and validates a manifest definition into a reusable template.
+#[cfg(feature = "signing")]
+pub fn compile_manifest(manifest_json: &str) -> Result<ManifestTemplate> {
+    // validate eagerly so errors surface at compile time, not per asset
+    Manifest::from_json(manifest_json).map_err(Error::from_c2pa_error)?;
+    let definition = serde_json::from_str(manifest_json).map_err(|e| Error::Json(e.to_string()))?;
+    Ok(ManifestTemplate { definition })
+}
+
+#[cfg(feature = "signing")]
+impl ManifestTemplate {
+    /// Builds a Manifest from the template, merging an optional JSON overlay
+    /// of per-asset top-level fields (e.g. title, instance_id).
+    pub fn instantiate(&self, overlay_json: Option<&str>) -> Result<Manifest> {
+        let mut definition = self.definition.clone();
+        if let Some(overlay_json) = overlay_json {
+            let overlay: serde_json::Value =
+                serde_json::from_str(overlay_json).map_err(|e| Error::Json(e.to_string()))?;
+            match (definition.as_object_mut(), overlay.as_object()) {
+                (Some(base), Some(overlay)) => {
+                    for (key, value) in overlay {
+                        base.insert(key.clone(), value.clone());
+                    }
+                }
+                _ => {
+                    return Err(Error::Json(
+                        "manifest overlay must be a JSON object".to_string(),
+                    ))
+                }
+            }
+        }
+        serde_json::from_value(definition).map_err(|e| Error::Json(e.to_string()))
+    }
+}
+
+/// Adds a manifest built from a compiled template to the source file and writes
+/// the result to the destination file.
+///
+/// overlay_json, if provided, is a small JSON object of per-asset top-level
+/// fields merged over the template.
+#[cfg(feature = "signing")]
+pub fn sign_file_with_template(
+    source: &str,
+    dest: &str,
+    template: &ManifestTemplate,
+    overlay_json: Option<&str>,
+    signer: &dyn Signer,
+    flags: u32,
+    data_dir: Option<String>,
+) -> Result<Vec<u8>> {
+    let manifest = template.instantiate(overlay_json)?;
+    embed_manifest_file(manifest, source, dest, signer, None, flags, data_dir)
+}
+
+/// Adds a manifest to an asset held in memory and returns the signed asset bytes.
+///
+/// The format must be a supported mime type or extension (e.g. "image/jpeg" or "jpg").
+/// A manifest definition must be supplied
+/// Signer information must also be supplied
+#[cfg(feature = "signing")]
+pub fn sign_buffer(
+    format: &str,
+    data: &[u8],
+    manifest_json: &str,
+    signer_info: &SignerInfo,
+) -> Result<Vec<u8>> {
     let signer = signer_info.signer()?;
+    sign_buffer_with_signer(format, data, manifest_json, &*signer)
+}
+
+/// Adds a manifest to an asset held in memory using an already constructed signer
+/// and returns the signed asset bytes.
+#[cfg(feature = "signing")]
+pub fn sign_buffer_with_signer(
+    format: &str,
+    data: &[u8],
+    manifest_json: &str,
+    signer: &dyn Signer,
+) -> Result<Vec<u8>> {
+    let mut manifest = Manifest::from_json(manifest_json).map_err(Error::from_c2pa_error)?;
+
+    // If the source asset has a manifest store, and no parent is specified, treat the source's manifest store as the parent.
+    if manifest.parent().is_none() {
+        let source_ingredient =
+            Ingredient::from_memory(format, data).map_err(Error::from_c2pa_error)?;
+        if source_ingredient.manifest_data().is_some() {
+            manifest
+                .set_parent(source_ingredient)
+                .map_err(Error::from_c2pa_error)?;
+        }
+    }
+
+    manifest
+        .embed_from_memory(format, data, signer)
+        .map_err(Error::from_c2pa_error)
+}
+
+/// Adds a manifest to the source stream and writes the signed asset to the destination stream
+/// using an already constructed signer.
+///
+/// The format must be a supported mime type or extension (e.g. "image/jpeg" or "jpg").
+/// Returns the binary manifest data for optional cloud storage
+#[cfg(feature = "signing")]
+pub fn sign_stream(
+    format: &str,
+    source: &mut dyn CAIRead,
+    dest: &mut dyn CAIReadWrite,
+    manifest_json: &str,
+    signer: &dyn Signer,
+) -> Result<Vec<u8>> {
+    let mut manifest = Manifest::from_json(manifest_json).map_err(Error::from_c2pa_error)?;
+
+    // If the source stream has a manifest store, and no parent is specified, treat the source's manifest store as the parent.
+    if manifest.parent().is_none() {
+        let source_ingredient =
+            Ingredient::from_stream(format, source).map_err(Error::from_c2pa_error)?;
+        if source_ingredient.manifest_data().is_some() {
+            manifest
+                .set_parent(source_ingredient)
+                .map_err(Error::from_c2pa_error)?;
+        }
+    }
+
+    source.rewind().map_err(|e| Error::Io(e.to_string()))?;
     manifest
-        .embed(&source, &dest, &*signer)
+        .embed_to_stream(format, source, dest, signer)
         .map_err(Error::from_c2pa_error)
 }
 
+/// Signs a batch of files over an internal worker pool.
+///
+/// The same manifest definition and signer information are used for every item.
+/// Each worker creates its own signer so key parsing happens once per thread,
+/// not once per asset.
+///
+/// thread_count of 0 uses the available parallelism of the host.
+/// on_complete is called once per item, from a worker thread, with the item
+/// index and the error if that item failed.
+///
+/// Returns the number of files signed successfully.
+#[cfg(feature = "signing")]
+pub fn sign_files_batch<F>(
+    sources: &[String],
+    dests: &[String],
+    manifest_json: &str,
+    signer_info: &SignerInfo,
+    thread_count: usize,
+    on_complete: F,
+) -> Result<usize>
+where
+    F: Fn(usize, Option<&Error>) + Sync,
+{
+    use std::sync::atomic::{AtomicUsize, Ordering};
+
+    if sources.len() != dests.len() {
+        return Err(Error::Other(
+            "source and destination counts must match".to_string(),
+        ));
+    }
+    // fail fast if the signer info cannot create a signer at all
+    signer_info.signer()?;
+
+    let threads = match thread_count {
+        0 => std::thread::available_parallelism()
+            .map(|n| n.get())
+            .unwrap_or(1),
+        n => n,
+    }
+    .clamp(1, sources.len().max(1));
+
+    let next = AtomicUsize::new(0);
+    let succeeded = AtomicUsize::new(0);
+    std::thread::scope(|scope| {
+        for _ in 0..threads {
+            scope.spawn(|| {
+                let signer = match signer_info.signer() {
+                    Ok(signer) => signer,
+                    Err(e) => {
+                        // report the failure for every item this worker claims
+                        loop {
+                            let i = next.fetch_add(1, Ordering::SeqCst);
+                            if i >= sources.len() {
+                                return;
+                            }
+                            on_complete(i, Some(&e));
+                        }
+                    }
+                };
+                loop {
+                    let i = next.fetch_add(1, Ordering::SeqCst);
+                    if i >= sources.len() {
+                        return;
+                    }
+                    match sign_file_with_signer(
+                        &sources[i],
+                        &dests[i],
+                        manifest_json,
+                        &*signer,
+                        None,
+                    ) {
+                        Ok(_) => {
+                            succeeded.fetch_add(1, Ordering::SeqCst);
+                            on_complete(i, None);
+                        }
+                        Err(e) => on_complete(i, Some(&e)),
+                    }
+                }
+            });
+        }
+    });
+    Ok(succeeded.load(Ordering::SeqCst))
+}
+
+/// Callback invoked when a submitted sign request completes, with the error
+/// if the request failed.
+#[cfg(feature = "signing")]
+pub type OnSignComplete = Box<dyn FnOnce(Option<&Error>) + Send>;
+
+#[cfg(feature = "signing")]
+struct SignJob {
+    source: String,
+    dest: String,
+    manifest_json: String,
+    on_complete: OnSignComplete,
+}
+
+#[cfg(feature = "signing")]
+struct SessionState {
+    pending: std::sync::Mutex<usize>,
+    idle: std::sync::Condvar,
+    succeeded: std::sync::atomic::AtomicUsize,
+}
+
+/// A long lived signing session over an internal worker pool.
+///
+/// Each worker parses its own signer when the session is created, so the
+/// certificate chain and private key are warm before the first request and
+/// signature operations never contend on a shared key. Submitted requests
+/// queue to whichever worker frees up first, so hashing, signing and
+/// timestamp authority round trips for different assets overlap instead of
+/// serializing in the caller.
+#[cfg(feature = "signing")]
+pub struct SignerSession {
+    sender: Option<std::sync::mpsc::Sender<SignJob>>,
+    workers: Vec<std::thread::JoinHandle<()>>,
+    state: std::sync::Arc<SessionState>,
+}
+
+#[cfg(feature = "signing")]
+impl SignerSession {
+    /// Creates a session with thread_count workers; 0 uses the available
+    /// parallelism of the host. Fails if the signer info cannot create a
+    /// signer.
+    pub fn new(signer_info: &SignerInfo, thread_count: usize) -> Result<Self> {
+        use std::sync::{atomic::AtomicUsize, mpsc, Arc, Condvar, Mutex};
+
+        // fail fast here; the per worker parses below happen asynchronously
+        signer_info.signer()?;
+
+        let threads = match thread_count {
+            0 => std::thread::available_parallelism()
+                .map(|n| n.get())
+                .unwrap_or(1),
+            n => n,
+        };
+        let (sender, receiver) = mpsc::channel::<SignJob>();
+        let receiver = Arc::new(Mutex::new(receiver));
+        let state = Arc::new(SessionState {
+            pending: Mutex::new(0),
+            idle: Condvar::new(),
+            succeeded: AtomicUsize::new(0),
+        });
+        let mut workers = Vec::with_capacity(threads);
+        for _ in 0..threads {
+            let signer_info = signer_info.clone();
+            let receiver = receiver.clone();
+            let state = state.clone();
+            workers.push(std::thread::spawn(move || {
+                // parsed at session creation, not on the first request
+                let signer = signer_info.signer();
+                loop {
+                    let job = match receiver.lock() {
+                        Ok(receiver) => receiver.recv(),
+                        Err(_) => return,
+                    };
+                    let Ok(job) = job else { return };
+                    match &signer {
+                        Ok(signer) => match sign_file_with_signer(
+                            &job.source,
+                            &job.dest,
+                            &job.manifest_json,
+                            &**signer,
+                            None,
+                        ) {
+                            Ok(_) => {
+                                state
+                                    .succeeded
+                                    .fetch_add(1, std::sync::atomic::Ordering::SeqCst);
+                                (job.on_complete)(None);
+                            }
+                            Err(e) => (job.on_complete)(Some(&e)),
+                        },
+                        Err(e) => (job.on_complete)(Some(e)),
+                    }
+                    if let Ok(mut pending) = state.pending.lock() {
+                        *pending -= 1;
+                        if *pending == 0 {
+                            state.idle.notify_all();
+                        }
+                    }
+                }
+            }));
+        }
+        Ok(SignerSession {
+            sender: Some(sender),
+            workers,
+            state,
+        })
+    }
+
+    /// Queues a sign request and returns immediately; on_complete runs on a
+    /// worker thread when the request finishes.
+    pub fn submit(
+        &self,
+        source: &str,
+        dest: &str,
+        manifest_json: &str,
+        on_complete: OnSignComplete,
+    ) -> Result<()> {
+        if let Ok(mut pending) = self.state.pending.lock() {
+            *pending += 1;
+        }
+        let job = SignJob {
+            source: source.to_string(),
+            dest: dest.to_string(),
+            manifest_json: manifest_json.to_string(),
+            on_complete,
+        };
+        let sent = match self.sender.as_ref() {
+            Some(sender) => sender.send(job).is_ok(),
+            None => false,
+        };
+        if !sent {
+            if let Ok(mut pending) = self.state.pending.lock() {
+                *pending -= 1;
+            }
+            return Err(Error::Other("signing session is closed".to_string()));
+        }
+        Ok(())
+    }
+
+    /// Blocks until every submitted request has completed and returns the
+    /// number signed successfully since the session was created.
+    pub fn wait(&self) -> usize {
+        if let Ok(mut pending) = self.state.pending.lock() {
+            while *pending != 0 {
+                pending = match self.state.idle.wait(pending) {
+                    Ok(pending) => pending,
+                    Err(_) => break,
+                };
+            }
+        }
+        self.state
+            .succeeded
+            .load(std::sync::atomic::Ordering::SeqCst)
+    }
+}
+
+#[cfg(feature = "signing")]
+impl Drop for SignerSession {
+    fn drop(&mut self) {
+        // closing the channel lets the workers drain and exit
+        drop(self.sender.take());
+        for worker in self.workers.drain(..) {
+            let _ = worker.join();
+        }
+    }
+}
+
+/// Reads a batch of files over an internal worker pool.
+///
+/// Workers pull paths from a shared queue so fast and slow assets balance
+/// across threads, keeping I/O and validation running on all cores from a
+/// single process.
+///
+/// thread_count of 0 uses the available parallelism of the host.
+/// on_result is called once per item, from a worker thread, with the item
+/// index and the ManifestStore report or the error for that item.
+///
+/// Returns the number of files read successfully.
+pub fn read_files<F>(paths: &[String], thread_count: usize, on_result: F) -> Result<usize>
+where
+    F: Fn(usize, std::result::Result<&str, &Error>) + Sync,
+{
+    use std::sync::atomic::{AtomicUsize, Ordering};
+
+    let threads = match thread_count {
+        0 => std::thread::available_parallelism()
+            .map(|n| n.get())
+            .unwrap_or(1),
+        n => n,
+    }
+    .clamp(1, paths.len().max(1));
+
+    let next = AtomicUsize::new(0);
+    let succeeded = AtomicUsize::new(0);
+    std::thread::scope(|scope| {
+        for _ in 0..threads {
+            scope.spawn(|| loop {
+                let i = next.fetch_add(1, Ordering::SeqCst);
+                if i >= paths.len() {
+                    return;
+                }
+                match read_file(&paths[i], None) {
+                    Ok(report) => {
+                        succeeded.fetch_add(1, Ordering::SeqCst);
+                        on_result(i, Ok(&report));
+                    }
+                    Err(e) => on_result(i, Err(&e)),
+                }
+            });
+        }
+    });
+    Ok(succeeded.load(Ordering::SeqCst))
+}
+
+/// An opt-in cache of verification results keyed by content identity.
+///
+/// The key is (file size, mtime, manifest box hash), so a cached report is
+/// only returned while the asset bytes and its manifest store are unchanged.
+/// Entries are evicted least recently used once capacity is reached. The
+/// cache is safe to share across threads.
+pub struct ReaderCache {
+    capacity: usize,
+    inner: std::sync::Mutex<ReaderCacheInner>,
+}
+
+#[derive(Default)]
+struct ReaderCacheInner {
+    // key -> (recency stamp, manifest store report)
+    entries: std::collections::HashMap<(u64, i64, Vec<u8>), (u64, String)>,
+    stamp: u64,
+    hits: u64,
+    misses: u64,
+}
+
+impl ReaderCache {
+    /// Creates a cache holding up to capacity verification results.
+    pub fn new(capacity: usize) -> Self {
+        Self {
+            capacity: capacity.max(1),
+            inner: std::sync::Mutex::new(ReaderCacheInner::default()),
+        }
+    }
+
+    /// Returns the hit and miss counts since the cache was created.
+    pub fn stats(&self) -> (u64, u64) {
+        match self.inner.lock() {
+            Ok(inner) => (inner.hits, inner.misses),
+            Err(_) => (0, 0),
+        }
+    }
+
+    // builds the content identity key for an asset, or None if the asset
+    // has no manifest store to verify
+    fn key(path: &str) -> Result<Option<(u64, i64, Vec<u8>)>> {
+        use sha2::{Digest, Sha256};
+
+        let metadata = std::fs::metadata(path).map_err(|e| Error::Io(e.to_string()))?;
+        let mtime = metadata
+            .modified()
+            .ok()
+            .and_then(|t| t.duration_since(std::time::UNIX_EPOCH).ok())
+            .map(|d| d.as_nanos() as i64)
+            .unwrap_or(0);
+        let jumbf = match c2pa::jumbf_io::load_jumbf_from_file(std::path::Path::new(path)) {
+            Ok(jumbf) => jumbf,
+            Err(c2pa::Error::JumbfNotFound) => return Ok(None),
+            Err(e) => return Err(Error::from_c2pa_error(e)),
+        };
+        Ok(Some((
+            metadata.len(),
+            mtime,
+            Sha256::digest(&jumbf).to_vec(),
+        )))
+    }
+}
+
+/// Returns ManifestStore JSON string from a file path, consulting the cache.
+///
+/// On a hit the cached report is returned without re-parsing or re-validating
+/// the manifest store; only the file metadata and manifest box are read to
+/// confirm the content identity. No binary resources are written, so this is
+/// for metadata-only verification paths.
+pub fn read_file_cached(cache: &ReaderCache, path: &str) -> Result<String> {
+    let key = match ReaderCache::key(path)? {
+        Some(key) => key,
+        // let the normal read path report the missing manifest store
+        None => return read_file(path, None),
+    };
+    if let Ok(mut inner) = cache.inner.lock() {
+        inner.stamp += 1;
+        let stamp = inner.stamp;
+        if let Some((recency, report)) = inner.entries.get_mut(&key) {
+            *recency = stamp;
+            let report = report.clone();
+            inner.hits += 1;
+            return Ok(report);
+        }
+        inner.misses += 1;
+    }
+    let report = read_file(path, None)?;
+    if let Ok(mut inner) = cache.inner.lock() {
+        inner.stamp += 1;
+        let stamp = inner.stamp;
+        if inner.entries.len() >= cache.capacity && !inner.entries.contains_key(&key) {
+            if let Some(oldest) = inner
+                .entries
+                .iter()
+                .min_by_key(|(_, (recency, _))| *recency)
+                .map(|(key, _)| key.clone())
+            {
+                inner.entries.remove(&oldest);
+            }
+        }
+        inner.entries.insert(key, (stamp, report.clone()));
+    }
+    Ok(report)
+}
+
+// Chunk size in bytes for the read/hash pipeline used by data hashed signing
+#[cfg(feature = "signing")]
+static HASH_CHUNK_SIZE: std::sync::atomic::AtomicUsize =
+    std::sync::atomic::AtomicUsize::new(8 * 1024 * 1024);
+
+// Number of chunks the reader may buffer ahead of the hasher
+#[cfg(feature = "signing")]
+static HASH_READAHEAD_CHUNKS: std::sync::atomic::AtomicUsize =
+    std::sync::atomic::AtomicUsize::new(4);
+
+/// Sets the chunk size in bytes for the data hash read/hash pipeline.
+///
+/// Zero restores the default of 8 MB.
+#[cfg(feature = "signing")]
+pub fn set_hash_chunk_size(bytes: usize) {
+    let bytes = if bytes == 0 { 8 * 1024 * 1024 } else { bytes };
+    HASH_CHUNK_SIZE.store(bytes, std::sync::atomic::Ordering::Relaxed);
+}
+
+/// Sets how many chunks the reader thread may buffer ahead of the hasher
+/// in the data hash pipeline.
+///
+/// Zero restores the default of 4 chunks.
+#[cfg(feature = "signing")]
+pub fn set_hash_readahead_chunks(chunks: usize) {
+    let chunks = if chunks == 0 { 4 } else { chunks };
+    HASH_READAHEAD_CHUNKS.store(chunks, std::sync::atomic::Ordering::Relaxed);
+}
+
+// Hashes the non-excluded byte ranges of a file, in order, using a reader
+// thread that stays ahead of the hashing thread so file reads overlap the
+// hash computation instead of serializing with it. The digest is identical
+// to the one the sdk computes for a DataHash with the same exclusions.
+#[cfg(feature = "signing")]
+fn hash_file_ranges(path: &str, alg: &str, exclusions: &[HashRange]) -> Result<Vec<u8>> {
+    use std::{
+        io::{Read, Seek, SeekFrom},
+        sync::{atomic::Ordering, mpsc::sync_channel},
+    };
+
+    use sha2::{Digest, Sha256, Sha384, Sha512};
+
+    enum Hasher {
+        Sha256(Sha256),
+        Sha384(Sha384),
+        Sha512(Sha512),
+    }
+    let mut hasher = match alg {
+        "sha256" => Hasher::Sha256(Sha256::new()),
+        "sha384" => Hasher::Sha384(Sha384::new()),
+        "sha512" => Hasher::Sha512(Sha512::new()),
+        _ => {
+            return Err(Error::NotSupported(format!(
+                "unsupported hash algorithm {alg}"
+            )))
+        }
+    };
+
+    let mut file = std::fs::File::open(path).map_err(|e| Error::Io(e.to_string()))?;
+    let file_len = file.metadata().map_err(|e| Error::Io(e.to_string()))?.len();
+
+    // convert the exclusions into the ordered list of ranges to hash
+    let mut exclusions: Vec<(u64, u64)> = exclusions
+        .iter()
+        .map(|r| (r.start() as u64, r.length() as u64))
+        .collect();
+    exclusions.sort_unstable();
+    let mut included: Vec<(u64, u64)> = Vec::new();
+    let mut pos = 0u64;
+    for (start, length) in exclusions {
+        if start + length > file_len {
+            return Err(Error::Other(
+                "exclusion range exceeds the asset length".to_string(),
+            ));
+        }
+        if start > pos {
+            included.push((pos, start - pos));
+        }
+        pos = pos.max(start + length);
+    }
+    if pos < file_len {
+        included.push((pos, file_len - pos));
+    }
+
+    let span = TraceSpan::begin(C2paTraceStage::C2paTraceDataHash);
+    let hashed_bytes: u64 = included.iter().map(|(_, length)| length).sum();
+
+    let chunk_size = HASH_CHUNK_SIZE.load(Ordering::Relaxed).max(1);
+    let readahead = HASH_READAHEAD_CHUNKS.load(Ordering::Relaxed).max(1);
+
+    let (sender, receiver) = sync_channel::<std::io::Result<Vec<u8>>>(readahead);
+    std::thread::scope(|scope| -> Result<()> {
+        scope.spawn(move || {
+            for (start, mut remaining) in included {
+                if let Err(e) = file.seek(SeekFrom::Start(start)) {
+                    let _ = sender.send(Err(e));
+                    return;
+                }
+                while remaining > 0 {
+                    let len = remaining.min(chunk_size as u64) as usize;
+                    let mut chunk = vec![0u8; len];
+                    match file.read_exact(&mut chunk) {
+                        Ok(()) => {
+                            if sender.send(Ok(chunk)).is_err() {
+                                return;
+                            }
+                        }
+                        Err(e) => {
+                            let _ = sender.send(Err(e));
+                            return;
+                        }
+                    }
+                    remaining -= len as u64;
+                }
+            }
+        });
+        for chunk in receiver {
+            let chunk = chunk.map_err(|e| Error::Io(e.to_string()))?;
+            match &mut hasher {
+                Hasher::Sha256(h) => h.update(&chunk),
+                Hasher::Sha384(h) => h.update(&chunk),
+                Hasher::Sha512(h) => h.update(&chunk),
+            }
+        }
+        Ok(())
+    })?;
+
+    finish_span(span, hashed_bytes);
+    Ok(match hasher {
+        Hasher::Sha256(h) => h.finalize().to_vec(),
+        Hasher::Sha384(h) => h.finalize().to_vec(),
+        Hasher::Sha512(h) => h.finalize().to_vec(),
+    })
+}
+
+/// Returns placeholder bytes for a data hashed manifest.
+///
+/// The placeholder is pre-formatted for insertion into an asset of the given
+/// format. The caller writes it into the output asset, hashes the result with
+/// the placeholder region excluded, and patches in the signed manifest from
+/// sign_data_hashed_manifest, which is the same size.
+///
+/// reserve_size must be at least the reserve_size of the signer that will
+/// sign the manifest.
+#[cfg(feature = "signing")]
+pub fn data_hash_placeholder(
+    manifest_json: &str,
+    reserve_size: usize,
+    format: &str,
+) -> Result<Vec<u8>> {
+    let mut manifest = Manifest::from_json(manifest_json).map_err(Error::from_c2pa_error)?;
+    manifest
+        .data_hash_placeholder(reserve_size, format)
+        .map_err(Error::from_c2pa_error)
+}
+
+// Decodes a hex digest string into bytes
+#[cfg(feature = "signing")]
+fn hex_to_bytes(hex: &str) -> Result<Vec<u8>> {
+    if !hex.len().is_multiple_of(2) {
+        return Err(Error::Json(
+            "hash hex string must have an even length".to_string(),
+        ));
+    }
+    (0..hex.len())
+        .step_by(2)
+        .map(|i| {
+            u8::from_str_radix(&hex[i..i + 2], 16)
+                .map_err(|_| Error::Json("hash is not a valid hex string".to_string()))
+        })
+        .collect()
+}
+
+/// Signs a manifest over a caller supplied data hash and returns the signed
+/// manifest bytes, pre-formatted to replace the placeholder in the asset.
+///
+/// data_hash_json holds a DataHash whose exclusions cover the placeholder
+/// region, e.g. {"exclusions": [{"start": 20, "length": 64000}],
+/// "name": "jumbf manifest", "alg": "sha256", "hash": [], "pad": []}.
+/// A digest the caller has already computed over the non-excluded ranges
+/// may be supplied in the hash field, as a hex string or an array of byte
+/// values, and is used as is so the asset is not hashed again. If the hash
+/// is empty and asset_path names the composed asset, the hash is computed
+/// here over the non-excluded ranges using the read/hash pipeline.
+#[cfg(feature = "signing")]
+pub fn sign_data_hashed_manifest(
+    manifest_json: &str,
+    signer: &dyn Signer,
+    format: &str,
+    data_hash_json: &str,
+    asset_path: Option<&str>,
+) -> Result<Vec<u8>> {
+    let mut manifest = Manifest::from_json(manifest_json).map_err(Error::from_c2pa_error)?;
+    let mut dh_value: serde_json::Value =
+        serde_json::from_str(data_hash_json).map_err(|e| Error::Json(e.to_string()))?;
+    if let Some(hash_hex) = dh_value.get("hash").and_then(|h| h.as_str()) {
+        dh_value["hash"] = serde_json::json!(hex_to_bytes(hash_hex)?);
+    }
+    let mut dh: DataHash =
+        serde_json::from_value(dh_value).map_err(|e| Error::Json(e.to_string()))?;
+    if dh.hash.is_empty() {
+        if let Some(path) = asset_path {
+            let alg = dh.alg.clone().unwrap_or_else(|| "sha256".to_string());
+            let exclusions = dh.exclusions.clone().unwrap_or_default();
+            dh.set_hash(hash_file_ranges(path, &alg, &exclusions)?);
+        }
+    }
+    // the claim requires a hash binding assertion; add the same dummy that
+    // data_hash_placeholder reserves space for, so the signed manifest is
+    // the same size as the placeholder, then the embeddable manifest
+    // replaces its content with the supplied data hash
+    let mut ph = DataHash::new("jumbf manifest", "sha256");
+    for _ in 0..10 {
+        ph.add_exclusion(HashRange::new(0, 2));
+    }
+    manifest
+        .add_assertion(&ph)
+        .map_err(Error::from_c2pa_error)?;
+    manifest
+        .data_hash_embeddable_manifest(&dh, signer, format, None)
+        .map_err(Error::from_c2pa_error)
+}
+
+/// Signs a manifest for the file at source_path without rewriting the asset
+/// and returns the signed manifest store bytes.
+///
+/// The asset is only read, to hash its bytes, so signing a large master does
+/// not copy it. With no remote_url the manifest is written as a detached
+/// .c2pa sidecar, to sidecar_path or next to the asset, where readers find
+/// it when the asset has no embedded manifest. With a remote_url the claim
+/// records that url as the manifest location and the returned bytes are for
+/// the caller to host there; a sidecar is then only written if sidecar_path
+/// is also given.
+#[cfg(feature = "signing")]
+pub fn sign_file_detached(
+    source_path: &str,
+    manifest_json: &str,
+    signer: &dyn Signer,
+    sidecar_path: Option<&str>,
+    remote_url: Option<&str>,
+) -> Result<Vec<u8>> {
+    use std::path::{Path, PathBuf};
+
+    let mut manifest = Manifest::from_json(manifest_json).map_err(Error::from_c2pa_error)?;
+    match remote_url {
+        Some(url) => {
+            manifest.set_remote_manifest(url);
+        }
+        None => {
+            manifest.set_sidecar_manifest();
+        }
+    }
+    // a detached manifest binds to the whole asset with no exclusions
+    let mut dh = DataHash::new("jumbf manifest", "sha256");
+    dh.set_hash(hash_file_ranges(source_path, "sha256", &[])?);
+    manifest
+        .add_assertion(&dh)
+        .map_err(Error::from_c2pa_error)?;
+    // the tiff composition is the identity transform, so this returns the
+    // raw jumbf store bytes that a .c2pa sidecar holds
+    let manifest_bytes = manifest
+        .data_hash_embeddable_manifest(&dh, signer, "tiff", None)
+        .map_err(Error::from_c2pa_error)?;
+
+    let sidecar = match (sidecar_path, remote_url) {
+        (Some(path), _) => Some(PathBuf::from(path)),
+        (None, None) => Some(Path::new(source_path).with_extension("c2pa")),
+        (None, Some(_)) => None,
+    };
+    if let Some(sidecar) = sidecar {
+        std::fs::write(sidecar, &manifest_bytes).map_err(|e| Error::Io(e.to_string()))?;
+    }
+    Ok(manifest_bytes)
+}
+
+// Extracts the active manifest's DataHash assertion from raw jumbf store
+// bytes. ManifestStore strips hard binding assertions when reading, so the
+// digest to reuse is only available from the store bytes themselves: the
+// assertion is the cbor box following its "c2pa.hash.data" label, and the
+// active manifest is the last one in the store.
+#[cfg(feature = "signing")]
+fn extract_data_hash(jumbf: &[u8]) -> Option<DataHash> {
+    let label = b"c2pa.hash.data\0";
+    let label_at = jumbf
+        .windows(label.len())
+        .enumerate()
+        .filter(|(_, window)| *window == label)
+        .map(|(at, _)| at)
+        .next_back()?;
+    // the cbor box header is a big endian length followed by the type
+    let cbor_at = jumbf[label_at..]
+        .windows(4)
+        .position(|window| window == b"cbor")?
+        + label_at;
+    let box_len = u32::from_be_bytes(jumbf.get(cbor_at - 4..cbor_at)?.try_into().ok()?) as usize;
+    let payload = jumbf.get(cbor_at + 4..cbor_at - 4 + box_len)?;
+    serde_cbor::from_slice(payload).ok()
+}
+
+/// Re-signs an already signed asset with an updated manifest, reusing the
+/// existing hard binding instead of re-hashing the asset.
+///
+/// The active manifest's data hash digest is carried over, so a
+/// metadata-only update skips the hashing and ingredient validation passes
+/// over the asset bytes; the destination file itself is still rewritten when
+/// the new store is spliced in. The previous store travels in the new one
+/// and its active manifest becomes the parent of the new claim. The recorded
+/// digest is trusted as is; callers that cannot trust the source asset
+/// should use sign_file, which re-hashes.
+#[cfg(feature = "signing")]
+pub fn resign_file(
+    source: &str,
+    dest: &str,
+    manifest_json: &str,
+    signer: &dyn Signer,
+    data_dir: Option<String>,
+) -> Result<Vec<u8>> {
+    use std::path::Path;
+
+    use c2pa::jumbf_io;
+
+    let source_path = Path::new(source);
+    let dest_path = Path::new(dest);
+
+    // the existing store carries the hard binding to reuse; parsing it
+    // through the c2pa handler with verify off never reads the asset bytes
+    let old_store_bytes =
+        jumbf_io::load_jumbf_from_file(source_path).map_err(Error::from_c2pa_error)?;
+    let old_store = ManifestStore::from_bytes("c2pa", &old_store_bytes, false)
+        .map_err(Error::from_c2pa_error)?;
+    let active = old_store
+        .get_active()
+        .ok_or_else(|| Error::ManifestNotFound("no active manifest".to_string()))?;
+    let old_dh = extract_data_hash(&old_store_bytes)
+        .filter(|dh| !dh.hash.is_empty())
+        .ok_or_else(|| {
+            Error::NotSupported("the active manifest has no data hash hard binding".to_string())
+        })?;
+    let alg = old_dh.alg.clone().unwrap_or_else(|| "sha256".to_string());
+
+    let span = TraceSpan::begin(C2paTraceStage::C2paTraceManifestParse);
+    let mut manifest = Manifest::from_json(manifest_json).map_err(Error::from_c2pa_error)?;
+    finish_span(span, manifest_json.len() as u64);
+    if let Some(path) = data_dir {
+        manifest
+            .with_base_path(path)
+            .map_err(Error::from_c2pa_error)?;
+    }
+    // preserve the provenance chain without the validation pass a
+    // full Ingredient::from_file would make over the asset
+    if manifest.parent().is_none() {
+        let mut parent = Ingredient::new(
+            active.title().unwrap_or(source),
+            active.format(),
+            active.instance_id(),
+        );
+        parent.set_is_parent();
+        if let Some(label) = old_store.active_label() {
+            parent.set_active_manifest(label);
+        }
+        parent
+            .set_manifest_data(old_store_bytes)
+            .map_err(Error::from_c2pa_error)?;
+        manifest
+            .set_parent(parent)
+            .map_err(Error::from_c2pa_error)?;
+    }
+
+    // a fixed size placeholder makes the new store length, and with it the
+    // hard binding exclusions, known before signing; the tiff composition is
+    // the identity transform, so these are raw jumbf store bytes
+    let placeholder = manifest
+        .data_hash_placeholder(signer.reserve_size(), "tiff")
+        .map_err(Error::from_c2pa_error)?;
+    jumbf_io::save_jumbf_to_file(&placeholder, source_path, Some(dest_path))
+        .map_err(Error::from_c2pa_error)?;
+
+    // the store is replaced in place, so the bytes outside it are unchanged
+    // and the digest recorded in the old claim still matches
+    let mut dh = DataHash::new("jumbf manifest", &alg);
+    for location in jumbf_io::object_locations(dest_path).map_err(Error::from_c2pa_error)? {
+        // the block type enum is not re-exported, so match on its Display name
+        if location.htype.to_string() == "Cai" {
+            dh.add_exclusion(HashRange::new(location.offset, location.length));
+        }
+    }
+    dh.set_hash(old_dh.hash.clone());
+
+    let manifest_bytes = manifest
+        .data_hash_embeddable_manifest(&dh, signer, "tiff", None)
+        .map_err(Error::from_c2pa_error)?;
+    if manifest_bytes.len() != placeholder.len() {
+        return Err(Error::Other(
+            "signed manifest does not match the placeholder size".to_string(),
+        ));
+    }
+    jumbf_io::save_jumbf_to_file(&manifest_bytes, dest_path, Some(dest_path))
+        .map_err(Error::from_c2pa_error)?;
+    Ok(manifest_bytes)
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -97,6 +1562,325 @@ mod tests {
         assert!(!json_report.contains("validation_status"));
     }
 
+    #[test]
+    fn test_read_file_mmap() {
+        let path = test_path("tests/fixtures/C.jpg");
+        let buffered = read_file(&path, None).unwrap();
+        set_mmap_read(true);
+        let mapped = read_file(&path, None);
+        set_mmap_read(false);
+        // the mapped read validates and reports exactly as the buffered one
+        assert_eq!(mapped.unwrap(), buffered);
+    }
+
+    #[test]
+    fn test_read_file_stream() {
+        let path = test_path("tests/fixtures/C.jpg");
+        let mut streamed = Vec::new();
+        read_file_stream(&path, &mut streamed).unwrap();
+        // the streamed report matches read_file byte for byte, including the
+        // base64 hash and omitted pad rewrites
+        let streamed = String::from_utf8(streamed).unwrap();
+        assert_eq!(streamed, read_file(&path, None).unwrap());
+    }
+
+    #[test]
+    fn test_read_file_selected() {
+        let path = test_path("tests/fixtures/C.jpg");
+        let result = read_file_selected(&path, "title, claim_generator");
+        assert!(result.is_ok());
+        let json_report = result.unwrap();
+        assert!(json_report.contains("C.jpg"));
+        assert!(json_report.contains("claim_generator"));
+        assert!(!json_report.contains("thumbnail"));
+    }
+
+    #[test]
+    fn test_read_ingredient_skip_thumbnails() {
+        let path = test_path("tests/fixtures/A.jpg");
+        let data_dir = "target/ingredient_no_thumbs";
+        if PathBuf::from(data_dir).exists() {
+            remove_dir_all(data_dir).unwrap();
+        }
+        let result = read_ingredient_file_with_flags(
+            &path,
+            data_dir,
+            C2PA_READ_SKIP_RESOURCES | C2PA_READ_SKIP_THUMBNAILS,
+        );
+        assert!(result.is_ok());
+        let json_report = result.unwrap();
+        assert!(!json_report.contains("thumbnail"));
+        // no resources should have been written
+        assert!(!PathBuf::from(data_dir).exists());
+    }
+
+    #[test]
+    fn test_read_ingredient_with_options() {
+        let path = test_path("tests/fixtures/A.jpg");
+        let options = IngredientExtractOptions {
+            flags: 0,
+            max_thumbnail_dimension: 256,
+            max_resource_bytes: 0,
+        };
+        let mut resources: Vec<(String, Vec<u8>)> = Vec::new();
+        let mut collect = |id: &str, data: &[u8]| resources.push((id.to_string(), data.to_vec()));
+        let result = read_ingredient_file_with_options(&path, None, &options, Some(&mut collect));
+        assert!(result.is_ok());
+
+        // the thumbnail is delivered in memory, downscaled to the cap
+        #[cfg(feature = "thumbnails")]
+        {
+            assert!(!resources.is_empty());
+            let thumbnail = image::load_from_memory(&resources[0].1).unwrap();
+            assert!(thumbnail.width().max(thumbnail.height()) <= 256);
+        }
+        #[cfg(not(feature = "thumbnails"))]
+        assert!(resources.is_empty());
+
+        // a one byte cap drops every resource
+        let options = IngredientExtractOptions {
+            flags: 0,
+            max_thumbnail_dimension: 0,
+            max_resource_bytes: 1,
+        };
+        let mut count = 0usize;
+        let mut count_resources = |_: &str, _: &[u8]| count += 1;
+        let result =
+            read_ingredient_file_with_options(&path, None, &options, Some(&mut count_resources));
+        assert!(result.is_ok());
+        assert_eq!(count, 0);
+    }
+
+    #[test]
+    fn test_has_manifest() {
+        assert!(has_manifest(&test_path("tests/fixtures/C.jpg")).unwrap());
+        assert!(!has_manifest(&test_path("tests/fixtures/A.jpg")).unwrap());
+        assert!(has_manifest(&test_path("tests/fixtures/Z.jpg")).is_err());
+    }
+
+    #[test]
+    fn test_read_from_buffer() {
+        let path = test_path("tests/fixtures/C.jpg");
+        let data = std::fs::read(path).unwrap();
+        let result = read_buffer("image/jpeg", &data);
+        assert!(result.is_ok());
+        let json_report = result.unwrap();
+        assert!(json_report.contains("C.jpg"));
+        assert!(!json_report.contains("validation_status"));
+    }
+
+    #[test]
+    fn test_read_from_stream() {
+        let path = test_path("tests/fixtures/C.jpg");
+        let data = std::fs::read(path).unwrap();
+        let mut stream = std::io::Cursor::new(data);
+        let result = read_stream("image/jpeg", &mut stream);
+        assert!(result.is_ok());
+        let json_report = result.unwrap();
+        assert!(json_report.contains("C.jpg"));
+    }
+
+    #[cfg(feature = "signing")]
+    #[test]
+    fn test_sign_stream() {
+        let path = test_path("tests/fixtures/C.jpg");
+        let data = std::fs::read(path).unwrap();
+        let signer_info = SignerInfo {
+            alg: "es256".to_string(),
+            sign_cert: std::fs::read(test_path("tests/fixtures/es256_certs.pem")).unwrap(),
+            private_key: std::fs::read(test_path("tests/fixtures/es256_private.key")).unwrap(),
+            ta_url: None,
+        };
+        let manifest = r#"{"claim_generator": "test", "title": "signed.jpg"}"#;
+        let signer = signer_info.signer().unwrap();
+        let mut source = std::io::Cursor::new(data);
+        let mut dest = std::io::Cursor::new(Vec::new());
+        let result = sign_stream("image/jpeg", &mut source, &mut dest, manifest, &*signer);
+        assert!(result.is_ok());
+        let json_report = read_buffer("image/jpeg", dest.get_ref()).unwrap();
+        assert!(json_report.contains("signed.jpg"));
+    }
+
+    #[cfg(feature = "signing")]
+    #[test]
+    fn test_sign_buffer() {
+        let path = test_path("tests/fixtures/C.jpg");
+        let data = std::fs::read(path).unwrap();
+        let signer_info = SignerInfo {
+            alg: "es256".to_string(),
+            sign_cert: std::fs::read(test_path("tests/fixtures/es256_certs.pem")).unwrap(),
+            private_key: std::fs::read(test_path("tests/fixtures/es256_private.key")).unwrap(),
+            ta_url: None,
+        };
+        let manifest = r#"{"claim_generator": "test", "title": "signed.jpg"}"#;
+        let result = sign_buffer("image/jpeg", &data, manifest, &signer_info);
+        assert!(result.is_ok());
+        let signed = result.unwrap();
+        // the signed asset should verify and contain our title
+        let json_report = read_buffer("image/jpeg", &signed).unwrap();
+        assert!(json_report.contains("signed.jpg"));
+    }
+
+    #[cfg(feature = "signing")]
+    #[test]
+    fn test_sign_file_with_options() {
+        let signer_info = SignerInfo {
+            alg: "es256".to_string(),
+            sign_cert: std::fs::read(test_path("tests/fixtures/es256_certs.pem")).unwrap(),
+            private_key: std::fs::read(test_path("tests/fixtures/es256_private.key")).unwrap(),
+            ta_url: None,
+        };
+        let manifest = r#"{"claim_generator": "test", "title": "options.jpg"}"#;
+        let signer = signer_info.signer().unwrap();
+        std::fs::create_dir_all(test_path("target/options")).unwrap();
+
+        // precomputed parent ingredient avoids the detection pass
+        let source = test_path("tests/fixtures/C.jpg");
+        let parent = Ingredient::from_file(&source).unwrap();
+        let dest = test_path("target/options/parent.jpg");
+        let result =
+            sign_file_with_options(&source, &dest, manifest, &*signer, Some(parent), 0, None);
+        assert!(result.is_ok());
+        let json_report = read_file(&dest, None).unwrap();
+        assert!(json_report.contains("parentOf"));
+
+        // skip parent detection on a source known to be unsigned
+        let source = test_path("tests/fixtures/A.jpg");
+        let dest = test_path("target/options/no_parent.jpg");
+        let result = sign_file_with_options(
+            &source,
+            &dest,
+            manifest,
+            &*signer,
+            None,
+            C2PA_SIGN_SKIP_PARENT_CHECK,
+            None,
+        );
+        assert!(result.is_ok());
+        let json_report = read_file(&dest, None).unwrap();
+        assert!(json_report.contains("options.jpg"));
+    }
+
+    #[cfg(feature = "signing")]
+    #[test]
+    fn test_sign_file_with_template() {
+        let signer_info = SignerInfo {
+            alg: "es256".to_string(),
+            sign_cert: std::fs::read(test_path("tests/fixtures/es256_certs.pem")).unwrap(),
+            private_key: std::fs::read(test_path("tests/fixtures/es256_private.key")).unwrap(),
+            ta_url: None,
+        };
+        let signer = signer_info.signer().unwrap();
+        let template =
+            compile_manifest(r#"{"claim_generator": "test", "title": "template.jpg"}"#).unwrap();
+        assert!(compile_manifest("not json").is_err());
+        std::fs::create_dir_all(test_path("target/template")).unwrap();
+
+        let source = test_path("tests/fixtures/A.jpg");
+        let dest = test_path("target/template/overlay.jpg");
+        let result = sign_file_with_template(
+            &source,
+            &dest,
+            &template,
+            Some(r#"{"title": "overlay.jpg"}"#),
+            &*signer,
+            C2PA_SIGN_SKIP_PARENT_CHECK,
+            None,
+        );
+        assert!(result.is_ok());
+        let json_report = read_file(&dest, None).unwrap();
+        assert!(json_report.contains("overlay.jpg"));
+    }
+
+    #[cfg(feature = "signing")]
+    #[test]
+    fn test_sign_files_batch() {
+        use std::sync::atomic::{AtomicUsize, Ordering};
+        let signer_info = SignerInfo {
+            alg: "es256".to_string(),
+            sign_cert: std::fs::read(test_path("tests/fixtures/es256_certs.pem")).unwrap(),
+            private_key: std::fs::read(test_path("tests/fixtures/es256_private.key")).unwrap(),
+            ta_url: None,
+        };
+        let manifest = r#"{"claim_generator": "test", "title": "batch.jpg"}"#;
+        let sources = vec![
+            test_path("tests/fixtures/C.jpg"),
+            test_path("tests/fixtures/A.jpg"),
+            test_path("tests/fixtures/Z.jpg"), // does not exist
+        ];
+        let dests = vec![
+            test_path("target/batch/C.jpg"),
+            test_path("target/batch/A.jpg"),
+            test_path("target/batch/Z.jpg"),
+        ];
+        std::fs::create_dir_all(test_path("target/batch")).unwrap();
+        let completed = AtomicUsize::new(0);
+        let failed = AtomicUsize::new(0);
+        let result = sign_files_batch(&sources, &dests, manifest, &signer_info, 2, |_i, error| {
+            completed.fetch_add(1, Ordering::SeqCst);
+            if error.is_some() {
+                failed.fetch_add(1, Ordering::SeqCst);
+            }
+        });
+        assert_eq!(result.unwrap(), 2);
+        assert_eq!(completed.load(Ordering::SeqCst), 3);
+        assert_eq!(failed.load(Ordering::SeqCst), 1);
+        let json_report = read_file(&dests[0], None).unwrap();
+        assert!(json_report.contains("batch.jpg"));
+    }
+
+    #[test]
+    #[cfg(feature = "signing")]
+    fn test_signer_session() {
+        use std::sync::{
+            atomic::{AtomicUsize, Ordering},
+            Arc,
+        };
+        let signer_info = SignerInfo {
+            alg: "es256".to_string(),
+            sign_cert: std::fs::read(test_path("tests/fixtures/es256_certs.pem")).unwrap(),
+            private_key: std::fs::read(test_path("tests/fixtures/es256_private.key")).unwrap(),
+            ta_url: None,
+        };
+        let manifest = r#"{"claim_generator": "test", "title": "session.jpg"}"#;
+        std::fs::create_dir_all(test_path("target/session")).unwrap();
+        let session = SignerSession::new(&signer_info, 2).unwrap();
+        let failed = Arc::new(AtomicUsize::new(0));
+        for i in 0..3 {
+            let failed = failed.clone();
+            session
+                .submit(
+                    &test_path("tests/fixtures/A.jpg"),
+                    &test_path(&format!("target/session/{i}.jpg")),
+                    manifest,
+                    Box::new(move |error| {
+                        if error.is_some() {
+                            failed.fetch_add(1, Ordering::SeqCst);
+                        }
+                    }),
+                )
+                .unwrap();
+        }
+        // a missing source fails through the callback, not the session
+        let failed_clone = failed.clone();
+        session
+            .submit(
+                &test_path("tests/fixtures/Z.jpg"),
+                &test_path("target/session/z.jpg"),
+                manifest,
+                Box::new(move |error| {
+                    if error.is_some() {
+                        failed_clone.fetch_add(1, Ordering::SeqCst);
+                    }
+                }),
+            )
+            .unwrap();
+        assert_eq!(session.wait(), 3);
+        assert_eq!(failed.load(Ordering::SeqCst), 1);
+        let json_report = read_file(&test_path("target/session/0.jpg"), None).unwrap();
+        assert!(json_report.contains("session.jpg"));
+    }
+
     #[test]
     fn test_read_from_file_with_base() {
         let path = test_path("tests/fixtures/C.jpg");
@@ -112,4 +1896,306 @@ mod tests {
         assert!(PathBuf::from(data_dir).exists());
         assert!(json_report.contains("thumbnail"));
     }
+
+    // returns the offset in a jpeg just past the leading APPn segments,
+    // where a manifest placeholder can be inserted
+    #[cfg(feature = "signing")]
+    fn jpeg_insertion_offset(jpeg: &[u8]) -> usize {
+        let mut offset = 2; // skip SOI
+        while offset + 4 <= jpeg.len()
+            && jpeg[offset] == 0xff
+            && (0xe0..=0xef).contains(&jpeg[offset + 1])
+        {
+            offset += 2 + ((jpeg[offset + 2] as usize) << 8 | jpeg[offset + 3] as usize);
+        }
+        offset
+    }
+
+    #[cfg(feature = "signing")]
+    #[test]
+    fn test_sign_data_hashed_manifest() {
+        use std::io::{Seek, SeekFrom, Write};
+
+        let signer_info = SignerInfo {
+            alg: "es256".to_string(),
+            sign_cert: std::fs::read(test_path("tests/fixtures/es256_certs.pem")).unwrap(),
+            private_key: std::fs::read(test_path("tests/fixtures/es256_private.key")).unwrap(),
+            ta_url: None,
+        };
+        let signer = signer_info.signer().unwrap();
+        let manifest_json = r#"{"claim_generator": "test", "title": "data_hashed.jpg"}"#;
+
+        let placeholder =
+            data_hash_placeholder(manifest_json, signer.reserve_size(), "image/jpeg").unwrap();
+
+        // compose the output asset with a hole for the manifest
+        let source = std::fs::read(test_path("tests/fixtures/A.jpg")).unwrap();
+        let offset = jpeg_insertion_offset(&source);
+        std::fs::create_dir_all(test_path("target/tmp")).unwrap();
+        let dest = test_path("target/tmp/data_hashed.jpg");
+        let mut file = std::fs::OpenOptions::new()
+            .read(true)
+            .write(true)
+            .create(true)
+            .truncate(true)
+            .open(&dest)
+            .unwrap();
+        file.write_all(&source[..offset]).unwrap();
+        file.write_all(&placeholder).unwrap();
+        file.write_all(&source[offset..]).unwrap();
+        file.flush().unwrap();
+
+        // hash everything but the placeholder region and sign
+        set_hash_chunk_size(1024); // exercise the chunked pipeline
+        let data_hash_json = format!(
+            r#"{{"exclusions": [{{"start": {}, "length": {}}}], "name": "jumbf manifest", "alg": "sha256", "hash": [], "pad": []}}"#,
+            offset,
+            placeholder.len()
+        );
+        let signed_manifest = sign_data_hashed_manifest(
+            manifest_json,
+            &*signer,
+            "image/jpeg",
+            &data_hash_json,
+            Some(&dest),
+        )
+        .unwrap();
+        set_hash_chunk_size(0);
+        assert_eq!(signed_manifest.len(), placeholder.len());
+
+        // patch the signed manifest over the placeholder and validate
+        file.seek(SeekFrom::Start(offset as u64)).unwrap();
+        file.write_all(&signed_manifest).unwrap();
+        drop(file);
+        let json_report = read_file(&dest, None).unwrap();
+        assert!(json_report.contains("data_hashed.jpg"));
+        assert!(!json_report.contains("validation_status"));
+    }
+
+    #[cfg(feature = "signing")]
+    #[test]
+    fn test_sign_file_detached() {
+        let signer_info = SignerInfo {
+            alg: "es256".to_string(),
+            sign_cert: std::fs::read(test_path("tests/fixtures/es256_certs.pem")).unwrap(),
+            private_key: std::fs::read(test_path("tests/fixtures/es256_private.key")).unwrap(),
+            ta_url: None,
+        };
+        let signer = signer_info.signer().unwrap();
+        let manifest_json = r#"{"claim_generator": "test", "title": "detached.jpg"}"#;
+
+        let source = std::fs::read(test_path("tests/fixtures/A.jpg")).unwrap();
+        std::fs::create_dir_all(test_path("target/tmp")).unwrap();
+        let asset = test_path("target/tmp/detached.jpg");
+        std::fs::write(&asset, &source).unwrap();
+
+        let manifest_bytes =
+            sign_file_detached(&asset, manifest_json, &*signer, None, None).unwrap();
+        assert!(!manifest_bytes.is_empty());
+
+        // the asset bytes are untouched and the sidecar holds the manifest
+        assert_eq!(std::fs::read(&asset).unwrap(), source);
+        let sidecar = test_path("target/tmp/detached.c2pa");
+        assert_eq!(std::fs::read(&sidecar).unwrap(), manifest_bytes);
+
+        // readers find and validate the manifest through the sidecar
+        let json_report = read_file(&asset, None).unwrap();
+        assert!(json_report.contains("detached.jpg"));
+        assert!(!json_report.contains("validation_status"));
+
+        // with a remote url and no sidecar path only the bytes are returned
+        std::fs::remove_file(&sidecar).unwrap();
+        let remote_bytes = sign_file_detached(
+            &asset,
+            manifest_json,
+            &*signer,
+            None,
+            Some("http://localhost/manifests/detached"),
+        )
+        .unwrap();
+        assert!(!remote_bytes.is_empty());
+        assert!(!PathBuf::from(&sidecar).exists());
+    }
+
+    #[cfg(feature = "signing")]
+    #[test]
+    fn test_resign_file() {
+        let signer_info = SignerInfo {
+            alg: "es256".to_string(),
+            sign_cert: std::fs::read(test_path("tests/fixtures/es256_certs.pem")).unwrap(),
+            private_key: std::fs::read(test_path("tests/fixtures/es256_private.key")).unwrap(),
+            ta_url: None,
+        };
+        let signer = signer_info.signer().unwrap();
+        std::fs::create_dir_all(test_path("target/tmp")).unwrap();
+
+        // sign normally first, then update the manifest without re-hashing
+        let signed = test_path("target/tmp/resign_base.jpg");
+        let manifest = r#"{"claim_generator": "test", "title": "original.jpg"}"#;
+        sign_file_with_signer(
+            &test_path("tests/fixtures/A.jpg"),
+            &signed,
+            manifest,
+            &*signer,
+            None,
+        )
+        .unwrap();
+
+        let updated = r#"{"claim_generator": "test", "title": "updated.jpg"}"#;
+        let dest = test_path("target/tmp/resign_updated.jpg");
+        let manifest_bytes = resign_file(&signed, &dest, updated, &*signer, None).unwrap();
+        assert!(!manifest_bytes.is_empty());
+
+        // the new claim validates against the reused hard binding and the
+        // original manifest is preserved as its parent
+        let json_report = read_file(&dest, None).unwrap();
+        assert!(json_report.contains("updated.jpg"));
+        assert!(json_report.contains("original.jpg"));
+        assert!(json_report.contains("parentOf"));
+        assert!(!json_report.contains("validation_status"));
+
+        // an unsigned asset cannot be incrementally re-signed
+        let result = resign_file(
+            &test_path("tests/fixtures/A.jpg"),
+            &dest,
+            updated,
+            &*signer,
+            None,
+        );
+        assert!(result.is_err());
+    }
+
+    #[test]
+    fn test_read_file_cbor() {
+        let path = test_path("tests/fixtures/C.jpg");
+        let cbor = read_file_cbor(&path).unwrap();
+        let value: serde_cbor::Value = serde_cbor::from_slice(&cbor).unwrap();
+        assert!(matches!(value, serde_cbor::Value::Map(_)));
+        // the CBOR report is smaller than the JSON text
+        let json = read_file(&path, None).unwrap();
+        assert!(cbor.len() < json.len());
+
+        let ingredient_cbor = read_ingredient_file_cbor(&path).unwrap();
+        let value: serde_cbor::Value = serde_cbor::from_slice(&ingredient_cbor).unwrap();
+        assert!(matches!(value, serde_cbor::Value::Map(_)));
+    }
+
+    #[test]
+    fn test_read_fragment_bad_data() {
+        // no fragmented BMFF fixtures exist, but a bad segment must return an
+        // error through the bounded poll loop rather than hang or panic
+        let bytes = std::fs::read(test_path("tests/fixtures/A.jpg")).unwrap();
+        let result = read_fragment("mp4", &bytes, &bytes);
+        assert!(result.is_err());
+    }
+
+    #[test]
+    fn test_read_files() {
+        use std::sync::atomic::{AtomicUsize, Ordering};
+
+        let paths = vec![
+            test_path("tests/fixtures/C.jpg"),
+            test_path("tests/fixtures/A.jpg"),
+            test_path("tests/fixtures/Z.jpg"),
+        ];
+        let reports = AtomicUsize::new(0);
+        let errors = AtomicUsize::new(0);
+        let succeeded = read_files(&paths, 2, |index, item| match item {
+            Ok(report) => {
+                assert_eq!(index, 0);
+                assert!(report.contains("C.jpg"));
+                reports.fetch_add(1, Ordering::SeqCst);
+            }
+            Err(_) => {
+                errors.fetch_add(1, Ordering::SeqCst);
+            }
+        })
+        .unwrap();
+        assert_eq!(succeeded, 1);
+        assert_eq!(reports.load(Ordering::SeqCst), 1);
+        assert_eq!(errors.load(Ordering::SeqCst), 2);
+    }
+
+    #[test]
+    fn test_read_file_cached() {
+        let path = test_path("tests/fixtures/C.jpg");
+        let cache = ReaderCache::new(4);
+
+        let first = read_file_cached(&cache, &path).unwrap();
+        let second = read_file_cached(&cache, &path).unwrap();
+        assert_eq!(first, second);
+        assert!(first.contains("C.jpg"));
+        assert_eq!(cache.stats(), (1, 1));
+
+        // an asset without a manifest store bypasses the cache
+        let no_manifest = test_path("tests/fixtures/A.jpg");
+        assert!(read_file_cached(&cache, &no_manifest).is_err());
+        assert_eq!(cache.stats(), (1, 1));
+
+        // a single entry cache evicts least recently used
+        std::fs::create_dir_all(test_path("target/tmp")).unwrap();
+        let copy = test_path("target/tmp/cached_copy.jpg");
+        std::fs::copy(&path, &copy).unwrap();
+        let cache = ReaderCache::new(1);
+        read_file_cached(&cache, &path).unwrap();
+        read_file_cached(&cache, &copy).unwrap();
+        read_file_cached(&cache, &path).unwrap();
+        assert_eq!(cache.stats(), (0, 3));
+    }
+
+    #[cfg(feature = "signing")]
+    #[test]
+    fn test_sign_data_hashed_presupplied_digest() {
+        use std::io::{Seek, SeekFrom, Write};
+
+        let signer_info = SignerInfo {
+            alg: "es256".to_string(),
+            sign_cert: std::fs::read(test_path("tests/fixtures/es256_certs.pem")).unwrap(),
+            private_key: std::fs::read(test_path("tests/fixtures/es256_private.key")).unwrap(),
+            ta_url: None,
+        };
+        let signer = signer_info.signer().unwrap();
+        let manifest_json = r#"{"claim_generator": "test", "title": "presupplied.jpg"}"#;
+
+        let placeholder =
+            data_hash_placeholder(manifest_json, signer.reserve_size(), "image/jpeg").unwrap();
+        let source = std::fs::read(test_path("tests/fixtures/A.jpg")).unwrap();
+        let offset = jpeg_insertion_offset(&source);
+        std::fs::create_dir_all(test_path("target/tmp")).unwrap();
+        let dest = test_path("target/tmp/presupplied.jpg");
+        let mut file = std::fs::OpenOptions::new()
+            .read(true)
+            .write(true)
+            .create(true)
+            .truncate(true)
+            .open(&dest)
+            .unwrap();
+        file.write_all(&source[..offset]).unwrap();
+        file.write_all(&placeholder).unwrap();
+        file.write_all(&source[offset..]).unwrap();
+        file.flush().unwrap();
+
+        // compute the digest up front, as an ingest pipeline would, and
+        // hand it to the sign call as a hex string with no asset path
+        let exclusions = [HashRange::new(offset, placeholder.len())];
+        let digest = hash_file_ranges(&dest, "sha256", &exclusions).unwrap();
+        let digest_hex: String = digest.iter().map(|b| format!("{b:02x}")).collect();
+        let data_hash_json = format!(
+            r#"{{"exclusions": [{{"start": {}, "length": {}}}], "name": "jumbf manifest", "alg": "sha256", "hash": "{}", "pad": []}}"#,
+            offset,
+            placeholder.len(),
+            digest_hex
+        );
+        let signed_manifest =
+            sign_data_hashed_manifest(manifest_json, &*signer, "image/jpeg", &data_hash_json, None)
+                .unwrap();
+        assert_eq!(signed_manifest.len(), placeholder.len());
+
+        file.seek(SeekFrom::Start(offset as u64)).unwrap();
+        file.write_all(&signed_manifest).unwrap();
+        drop(file);
+        let json_report = read_file(&dest, None).unwrap();
+        assert!(json_report.contains("presupplied.jpg"));
+        assert!(!json_report.contains("validation_status"));
+    }
 }
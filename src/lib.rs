@@ -11,11 +11,18 @@
 // each license.
 
 mod c_api;
+mod c_stream;
 /// This module exports a C2PA library
 mod error;
 mod json_api;
+mod settings;
+#[cfg(feature = "signing")]
 mod signer_info;
+mod trace;
 
 pub use error::{Error, Result};
 pub use json_api::*;
+pub use settings::{settings_load_json, settings_reset, settings_set};
+#[cfg(feature = "signing")]
 pub use signer_info::SignerInfo;
+pub use trace::{set_trace_callback, C2paTraceStage};
@@ -0,0 +1,124 @@
+// Copyright 2023 Adobe. All rights reserved.
+// This file is licensed to you under the Apache License,
+// Version 2.0 (http://www.apache.org/licenses/LICENSE-2.0)
+// or the MIT license (http://opensource.org/licenses/MIT),
+// at your option.
+// Unless required by applicable law or agreed to in writing,
+// this software is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR REPRESENTATIONS OF ANY KIND, either express or
+// implied. See the LICENSE-MIT and LICENSE-APACHE files for the
+// specific language governing permissions and limitations under
+// each license.
+
+//! A single named settings surface over the library's tuning knobs.
+//!
+//! The knobs themselves stay plain atomics read directly by the hot paths,
+//! so consulting a setting never takes a lock; this module only gives them
+//! names so deployments can be configured from one JSON object instead of
+//! one call per knob.
+
+#[cfg(feature = "signing")]
+use crate::signer_info;
+use crate::{json_api, Error, Result};
+
+// Settings addressable by name; the signing knobs are absent from the
+// verify only build
+const SETTING_KEYS: &[&str] = &[
+    "mmap_read",
+    #[cfg(feature = "signing")]
+    "hash_chunk_size",
+    #[cfg(feature = "signing")]
+    "hash_readahead_chunks",
+    #[cfg(feature = "signing")]
+    "timestamp_cache_ttl",
+];
+
+/// Applies one named setting.
+///
+/// Known keys are "mmap_read", "hash_chunk_size", "hash_readahead_chunks"
+/// and "timestamp_cache_ttl"; the last three exist only when the library is
+/// built with signing support. Unknown keys are an error.
+pub fn settings_set(key: &str, value: u64) -> Result<()> {
+    match key {
+        "mmap_read" => json_api::set_mmap_read(value != 0),
+        #[cfg(feature = "signing")]
+        "hash_chunk_size" => json_api::set_hash_chunk_size(value as usize),
+        #[cfg(feature = "signing")]
+        "hash_readahead_chunks" => json_api::set_hash_readahead_chunks(value as usize),
+        #[cfg(feature = "signing")]
+        "timestamp_cache_ttl" => signer_info::set_timestamp_cache_ttl(value),
+        key => return Err(Error::NotSupported(format!("unknown setting {key}"))),
+    }
+    Ok(())
+}
+
+/// Applies a flat JSON object of settings, e.g.
+/// `{"hash_chunk_size": 4194304, "mmap_read": true}`.
+///
+/// Values must be unsigned integers or booleans. The whole object is
+/// validated before anything is applied, so a typo cannot leave the
+/// settings half changed.
+pub fn settings_load_json(json: &str) -> Result<()> {
+    let object: serde_json::Map<String, serde_json::Value> =
+        serde_json::from_str(json).map_err(|e| Error::Json(e.to_string()))?;
+    let mut entries = Vec::with_capacity(object.len());
+    for (key, value) in &object {
+        if !SETTING_KEYS.contains(&key.as_str()) {
+            return Err(Error::NotSupported(format!("unknown setting {key}")));
+        }
+        let value = match value {
+            serde_json::Value::Bool(flag) => *flag as u64,
+            value => value.as_u64().ok_or_else(|| {
+                Error::Json(format!(
+                    "setting {key} must be an unsigned integer or boolean"
+                ))
+            })?,
+        };
+        entries.push((key.as_str(), value));
+    }
+    for (key, value) in entries {
+        settings_set(key, value)?;
+    }
+    Ok(())
+}
+
+/// Restores every setting to its built-in default.
+pub fn settings_reset() {
+    json_api::set_mmap_read(false);
+    #[cfg(feature = "signing")]
+    {
+        json_api::set_hash_chunk_size(0);
+        json_api::set_hash_readahead_chunks(0);
+        signer_info::set_timestamp_cache_ttl(0);
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_settings() {
+        assert!(settings_set("mmap_read", 1).is_ok());
+        assert!(settings_set("no_such_setting", 1).is_err());
+
+        let result = settings_load_json(r#"{"mmap_read": true}"#);
+        assert!(result.is_ok());
+
+        // nothing is applied when any entry is invalid
+        assert!(settings_load_json(r#"{"mmap_read": "yes"}"#).is_err());
+        assert!(settings_load_json(r#"{"no_such_setting": 1}"#).is_err());
+
+        settings_reset();
+    }
+
+    #[test]
+    #[cfg(feature = "signing")]
+    fn test_settings_signing_keys() {
+        let result = settings_load_json(
+            r#"{"hash_chunk_size": 1048576, "hash_readahead_chunks": 2, "timestamp_cache_ttl": 60}"#,
+        );
+        assert!(result.is_ok());
+        settings_reset();
+    }
+}
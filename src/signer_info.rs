@@ -10,10 +10,112 @@
 // specific language governing permissions and limitations under
 // each license.
 
+use std::{
+    collections::BTreeMap,
+    sync::{
+        atomic::{AtomicU64, Ordering},
+        Mutex,
+    },
+    time::{Duration, Instant},
+};
+
 use c2pa::{create_signer, Signer, SigningAlg};
 use serde::Deserialize;
 
-use crate::{Error, Result};
+use crate::{
+    trace::{finish_span, C2paTraceStage, TraceSpan},
+    Error, Result,
+};
+
+// Time to live in seconds for cached timestamp authority responses
+// Zero disables the cache, which is the default
+static TSA_CACHE_TTL: AtomicU64 = AtomicU64::new(0);
+
+// A cached timestamp authority response and the moment it was cached
+type TsaCacheEntry = (Instant, Vec<u8>);
+
+// Cached timestamp authority responses, keyed by the exact message that
+// was timestamped. A response is only ever returned for a byte identical
+// message, so cached responses verify exactly as fresh ones do.
+static TSA_CACHE: Mutex<BTreeMap<Vec<u8>, TsaCacheEntry>> = Mutex::new(BTreeMap::new());
+
+/// Sets the time to live in seconds for cached timestamp authority responses.
+///
+/// While set, a repeated timestamp request for the same message within the
+/// window is answered from the cache instead of a new round trip to the
+/// timestamp server, which also rides out short TSA outages. Setting zero
+/// disables the cache and drops any cached responses.
+pub fn set_timestamp_cache_ttl(seconds: u64) {
+    TSA_CACHE_TTL.store(seconds, Ordering::Relaxed);
+    if seconds == 0 {
+        if let Ok(mut cache) = TSA_CACHE.lock() {
+            cache.clear();
+        }
+    }
+}
+
+// A signer wrapper that caches timestamp authority responses process-wide
+// so identical timestamp requests share one round trip to the TSA
+struct TimestampCachingSigner {
+    inner: Box<dyn Signer>,
+}
+
+impl Signer for TimestampCachingSigner {
+    fn sign(&self, data: &[u8]) -> c2pa::Result<Vec<u8>> {
+        self.inner.sign(data)
+    }
+
+    fn alg(&self) -> SigningAlg {
+        self.inner.alg()
+    }
+
+    fn certs(&self) -> c2pa::Result<Vec<Vec<u8>>> {
+        self.inner.certs()
+    }
+
+    fn reserve_size(&self) -> usize {
+        self.inner.reserve_size()
+    }
+
+    fn time_authority_url(&self) -> Option<String> {
+        self.inner.time_authority_url()
+    }
+
+    fn timestamp_request_headers(&self) -> Option<Vec<(String, String)>> {
+        self.inner.timestamp_request_headers()
+    }
+
+    fn send_timestamp_request(&self, message: &[u8]) -> Option<c2pa::Result<Vec<u8>>> {
+        let ttl = TSA_CACHE_TTL.load(Ordering::Relaxed);
+        if ttl == 0 {
+            let span = TraceSpan::begin(C2paTraceStage::C2paTraceTimestamp);
+            let result = self.inner.send_timestamp_request(message);
+            finish_span(span, message.len() as u64);
+            return result;
+        }
+        let ttl = Duration::from_secs(ttl);
+        let now = Instant::now();
+        if let Ok(mut cache) = TSA_CACHE.lock() {
+            cache.retain(|_, (at, _)| now.duration_since(*at) < ttl);
+            if let Some((_, response)) = cache.get(message) {
+                return Some(Ok(response.clone()));
+            }
+        }
+        let span = TraceSpan::begin(C2paTraceStage::C2paTraceTimestamp);
+        let result = self.inner.send_timestamp_request(message);
+        finish_span(span, message.len() as u64);
+        if let Some(Ok(response)) = &result {
+            if let Ok(mut cache) = TSA_CACHE.lock() {
+                cache.insert(message.to_vec(), (now, response.clone()));
+            }
+        }
+        result
+    }
+
+    fn ocsp_val(&self) -> Option<Vec<u8>> {
+        self.inner.ocsp_val()
+    }
+}
 
 /// SignerInfo provides the information needed to create a signer
 /// and sign a manifest.
@@ -48,12 +150,71 @@ impl SignerInfo {
 
     /// Create a signer from the SignerInfo
     pub fn signer(&self) -> Result<Box<dyn Signer>> {
-        create_signer::from_keys(
+        let span = TraceSpan::begin(C2paTraceStage::C2paTraceSignerParse);
+        let signer = create_signer::from_keys(
             &self.sign_cert,
             &self.private_key,
             self.alg()?,
             self.ta_url.clone(),
         )
-        .map_err(Error::from_c2pa_error)
+        .map_err(Error::from_c2pa_error)?;
+        finish_span(span, (self.sign_cert.len() + self.private_key.len()) as u64);
+        Ok(match self.ta_url {
+            Some(_) => Box::new(TimestampCachingSigner { inner: signer }),
+            None => signer,
+        })
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use std::sync::{atomic::AtomicUsize, Arc};
+
+    use super::*;
+
+    // A signer stub that counts timestamp requests and never hits the network
+    struct StubSigner {
+        requests: Arc<AtomicUsize>,
+    }
+
+    impl Signer for StubSigner {
+        fn sign(&self, _data: &[u8]) -> c2pa::Result<Vec<u8>> {
+            Ok(Vec::new())
+        }
+        fn alg(&self) -> SigningAlg {
+            SigningAlg::Es256
+        }
+        fn certs(&self) -> c2pa::Result<Vec<Vec<u8>>> {
+            Ok(Vec::new())
+        }
+        fn reserve_size(&self) -> usize {
+            1024
+        }
+        fn send_timestamp_request(&self, _message: &[u8]) -> Option<c2pa::Result<Vec<u8>>> {
+            self.requests.fetch_add(1, Ordering::Relaxed);
+            Some(Ok(b"timestamp".to_vec()))
+        }
+    }
+
+    #[test]
+    fn test_timestamp_cache() {
+        let requests = Arc::new(AtomicUsize::new(0));
+        let signer = TimestampCachingSigner {
+            inner: Box::new(StubSigner {
+                requests: requests.clone(),
+            }),
+        };
+        set_timestamp_cache_ttl(60);
+        let first = signer.send_timestamp_request(b"test_timestamp_cache message");
+        let second = signer.send_timestamp_request(b"test_timestamp_cache message");
+        set_timestamp_cache_ttl(0);
+
+        // the second request for the same message is served from the cache
+        assert_eq!(requests.load(Ordering::Relaxed), 1);
+        assert_eq!(first.unwrap().unwrap(), second.unwrap().unwrap());
+
+        // with the cache disabled every request goes to the authority
+        signer.send_timestamp_request(b"test_timestamp_cache message");
+        assert_eq!(requests.load(Ordering::Relaxed), 2);
     }
 }
@@ -0,0 +1,156 @@
+// Copyright 2023 Adobe. All rights reserved.
+// This file is licensed to you under the Apache License,
+// Version 2.0 (http://www.apache.org/licenses/LICENSE-2.0)
+// or the MIT license (http://opensource.org/licenses/MIT),
+// at your option.
+// Unless required by applicable law or agreed to in writing,
+// this software is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR REPRESENTATIONS OF ANY KIND, either express or
+// implied. See the LICENSE-MIT and LICENSE-APACHE files for the
+// specific language governing permissions and limitations under
+// each license.
+
+use std::{
+    os::raw::c_void,
+    sync::atomic::{AtomicUsize, Ordering},
+    time::{Instant, SystemTime, UNIX_EPOCH},
+};
+
+/// Identifies the phase of a read or sign call reported to a trace callback.
+///
+/// These values are published in c2pa.h and recorded by external tracing
+/// systems; never renumber or remove an entry, only append new ones.
+#[repr(C)]
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub enum C2paTraceStage {
+    /// Parsing and validating a manifest store on the read path
+    C2paTraceReadManifest = 0,
+    /// Parsing a manifest definition JSON on the sign path
+    C2paTraceManifestParse = 1,
+    /// Parsing the certificates and private key into a signer
+    C2paTraceSignerParse = 2,
+    /// Hashing the asset, signing the claim and writing the output
+    C2paTraceEmbed = 3,
+    /// A timestamp authority round trip (cache hits are not reported)
+    C2paTraceTimestamp = 4,
+    /// The chunked read/hash pipeline over asset byte ranges
+    C2paTraceDataHash = 5,
+}
+
+/// The callback signature for trace events.
+///
+/// stage identifies the phase, start_ns is the wall clock start in
+/// nanoseconds since the unix epoch, duration_ns is the elapsed time and
+/// bytes is the payload size the stage worked over (0 when not meaningful).
+pub type TraceCallback = unsafe extern "C" fn(
+    stage: C2paTraceStage,
+    start_ns: u64,
+    duration_ns: u64,
+    bytes: u64,
+    context: *mut c_void,
+);
+
+// The registered callback and its context, stored as usizes so hot paths
+// can check for a callback with a single atomic load
+static TRACE_CALLBACK: AtomicUsize = AtomicUsize::new(0);
+static TRACE_CONTEXT: AtomicUsize = AtomicUsize::new(0);
+
+/// Registers a process-wide trace callback, or unregisters it with None.
+///
+/// The callback may be invoked from any thread, including internal worker
+/// threads, and must be thread safe along with its context.
+pub fn set_trace_callback(callback: Option<TraceCallback>, context: *mut c_void) {
+    // clear the callback first so an emit on another thread never pairs the
+    // old callback with the new context or vice versa
+    TRACE_CALLBACK.store(0, Ordering::SeqCst);
+    TRACE_CONTEXT.store(context as usize, Ordering::SeqCst);
+    if let Some(callback) = callback {
+        TRACE_CALLBACK.store(callback as usize, Ordering::SeqCst);
+    }
+}
+
+// An in-progress stage measurement; created when a stage starts and
+// reported when finished. When no callback is registered begin returns
+// None and the only cost on the hot path is one atomic load.
+pub(crate) struct TraceSpan {
+    stage: C2paTraceStage,
+    start_ns: u64,
+    started: Instant,
+}
+
+impl TraceSpan {
+    pub(crate) fn begin(stage: C2paTraceStage) -> Option<TraceSpan> {
+        if TRACE_CALLBACK.load(Ordering::Relaxed) == 0 {
+            return None;
+        }
+        let start_ns = SystemTime::now()
+            .duration_since(UNIX_EPOCH)
+            .map(|d| d.as_nanos() as u64)
+            .unwrap_or(0);
+        Some(TraceSpan {
+            stage,
+            start_ns,
+            started: Instant::now(),
+        })
+    }
+
+    pub(crate) fn finish(self, bytes: u64) {
+        let callback = TRACE_CALLBACK.load(Ordering::Relaxed);
+        if callback == 0 {
+            return;
+        }
+        let duration_ns = self.started.elapsed().as_nanos() as u64;
+        let context = TRACE_CONTEXT.load(Ordering::Relaxed) as *mut c_void;
+        let callback: TraceCallback = unsafe { std::mem::transmute(callback) };
+        unsafe { callback(self.stage, self.start_ns, duration_ns, bytes, context) };
+    }
+}
+
+// Reports a finished span over an Option from begin, so call sites stay
+// one line in the instrumented paths
+pub(crate) fn finish_span(span: Option<TraceSpan>, bytes: u64) {
+    if let Some(span) = span {
+        span.finish(bytes);
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::sync::atomic::AtomicU64;
+
+    // byte count no instrumented path produces, so the callback can tell
+    // this test's span from spans finished by concurrently running tests
+    const SENTINEL_BYTES: u64 = u64::MAX - 42;
+
+    static SENTINEL_EVENTS: AtomicU64 = AtomicU64::new(0);
+
+    unsafe extern "C" fn record(
+        _stage: C2paTraceStage,
+        start_ns: u64,
+        _duration_ns: u64,
+        bytes: u64,
+        _context: *mut c_void,
+    ) {
+        assert!(start_ns > 0);
+        // the callback is process global, so instrumented spans from other
+        // tests in the suite land here too; only count our own
+        if bytes == SENTINEL_BYTES {
+            SENTINEL_EVENTS.fetch_add(1, Ordering::Relaxed);
+        }
+    }
+
+    #[test]
+    fn test_trace_spans() {
+        // no callback registered: begin short-circuits
+        assert!(TraceSpan::begin(C2paTraceStage::C2paTraceEmbed).is_none());
+
+        set_trace_callback(Some(record), std::ptr::null_mut());
+        let span = TraceSpan::begin(C2paTraceStage::C2paTraceEmbed);
+        assert!(span.is_some());
+        finish_span(span, SENTINEL_BYTES);
+        set_trace_callback(None, std::ptr::null_mut());
+
+        assert_eq!(SENTINEL_EVENTS.load(Ordering::Relaxed), 1);
+    }
+}
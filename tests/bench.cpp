@@ -0,0 +1,176 @@
+// Copyright 2023 Adobe. All rights reserved.
+// This file is licensed to you under the Apache License,
+// Version 2.0 (http://www.apache.org/licenses/LICENSE-2.0)
+// or the MIT license (http://opensource.org/licenses/MIT),
+// at your option.
+// Unless required by applicable law or agreed to in writing,
+// this software is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR REPRESENTATIONS OF ANY KIND, either express or
+// implied. See the LICENSE-MIT and LICENSE-APACHE files for the
+// specific language governing permissions and limitations under
+// each license.
+
+// Benchmark harness for the C API (make bench).
+//
+// Drives c2pa_read_file and c2pa_sign_file over the fixtures at several
+// asset sizes and reports ops/sec, p50/p99 latency and peak RSS as one
+// JSON line per workload, so results can be diffed across releases.
+// Larger assets are derived from A.jpg by inserting padding COM segments,
+// which keeps them valid JPEGs that exercise the full hashing path.
+// Signing uses no timestamp authority so results are hermetic.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+
+#include "../include/c2pa.h"
+
+using std::string;
+using std::vector;
+
+// read a whole file into a byte vector, exiting on failure
+static vector<uint8_t> load_file(const string &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        fprintf(stderr, "bench: cannot read %s\n", path.c_str());
+        exit(1);
+    }
+    return vector<uint8_t>(std::istreambuf_iterator<char>(file), {});
+}
+
+// offset just past the leading APPn segments, where padding can be inserted
+static size_t jpeg_insertion_offset(const vector<uint8_t> &jpeg)
+{
+    size_t offset = 2; // past SOI
+    while (offset + 4 <= jpeg.size() && jpeg[offset] == 0xff &&
+           jpeg[offset + 1] >= 0xe0 && jpeg[offset + 1] <= 0xef)
+    {
+        offset += 2 + ((jpeg[offset + 2] << 8) | jpeg[offset + 3]);
+    }
+    return offset;
+}
+
+// write a copy of the base jpeg grown to at least target_size bytes by
+// inserting COM segments of padding, keeping it a valid asset
+static void write_padded_jpeg(const vector<uint8_t> &base, size_t target_size, const string &dest)
+{
+    const size_t payload = 65533; // max segment payload including the length field
+    vector<uint8_t> padded;
+    padded.reserve(std::max(base.size(), target_size) + payload);
+    size_t offset = jpeg_insertion_offset(base);
+    padded.insert(padded.end(), base.begin(), base.begin() + offset);
+    while (padded.size() + (base.size() - offset) < target_size)
+    {
+        padded.push_back(0xff);
+        padded.push_back(0xfe);
+        padded.push_back(payload >> 8);
+        padded.push_back(payload & 0xff);
+        padded.insert(padded.end(), payload - 2, 0);
+    }
+    padded.insert(padded.end(), base.begin() + offset, base.end());
+
+    std::ofstream file(dest, std::ios::binary);
+    file.write((const char *)padded.data(), padded.size());
+}
+
+// run op repeatedly for roughly one second and print one JSON result line
+static void run_bench(const string &name, size_t asset_size, const std::function<void()> &op)
+{
+    using clock = std::chrono::steady_clock;
+    vector<double> latencies_us;
+    auto bench_start = clock::now();
+    while (latencies_us.size() < 200)
+    {
+        auto start = clock::now();
+        op();
+        auto end = clock::now();
+        latencies_us.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+        if (latencies_us.size() >= 5 &&
+            std::chrono::duration<double>(end - bench_start).count() >= 1.0)
+        {
+            break;
+        }
+    }
+    double total_s = std::chrono::duration<double>(clock::now() - bench_start).count();
+
+    std::sort(latencies_us.begin(), latencies_us.end());
+    size_t count = latencies_us.size();
+    double p50 = latencies_us[count / 2];
+    double p99 = latencies_us[std::min(count - 1, (count * 99) / 100)];
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    long peak_rss_kb = usage.ru_maxrss;
+#ifdef __APPLE__
+    peak_rss_kb /= 1024; // ru_maxrss is bytes on Darwin
+#endif
+
+    printf("{\"bench\": \"%s\", \"asset_bytes\": %zu, \"iterations\": %zu, "
+           "\"ops_per_sec\": %.2f, \"p50_us\": %.1f, \"p99_us\": %.1f, "
+           "\"peak_rss_kb\": %ld}\n",
+           name.c_str(), asset_size, count, count / total_s, p50, p99, peak_rss_kb);
+}
+
+int main(void)
+{
+    std::filesystem::create_directories("target/tmp");
+
+    vector<uint8_t> certs = load_file("tests/fixtures/es256_certs.pem");
+    vector<uint8_t> private_key = load_file("tests/fixtures/es256_private.key");
+    certs.push_back(0);
+    private_key.push_back(0);
+    vector<uint8_t> manifest = load_file("tests/fixtures/training.json");
+    manifest.push_back(0);
+    C2paSignerInfo sign_info = {.alg = "es256",
+                                .sign_cert = (const char *)certs.data(),
+                                .private_key = (const char *)private_key.data(),
+                                .ta_url = NULL};
+
+    vector<uint8_t> base = load_file("tests/fixtures/A.jpg");
+    const size_t sizes[] = {0, 1 << 20, 8 << 20}; // as-is, 1 MB, 8 MB
+
+    for (size_t target : sizes)
+    {
+        string source = "target/tmp/bench_" + std::to_string(target) + ".jpg";
+        string signed_dest = "target/tmp/bench_signed_" + std::to_string(target) + ".jpg";
+        write_padded_jpeg(base, target, source);
+        size_t asset_size = std::filesystem::file_size(source);
+
+        run_bench("sign_file", asset_size, [&]() {
+            char *result = c2pa_sign_file(source.c_str(), signed_dest.c_str(),
+                                          (const char *)manifest.data(), &sign_info,
+                                          "tests/fixtures");
+            if (result == NULL)
+            {
+                char *err = c2pa_error();
+                fprintf(stderr, "bench: c2pa_sign_file failed: %s\n", err);
+                c2pa_release_string(err);
+                exit(1);
+            }
+            c2pa_release_string(result);
+        });
+
+        run_bench("read_file", asset_size, [&]() {
+            char *result = c2pa_read_file(signed_dest.c_str(), NULL);
+            if (result == NULL)
+            {
+                char *err = c2pa_error();
+                fprintf(stderr, "bench: c2pa_read_file failed: %s\n", err);
+                c2pa_release_string(err);
+                exit(1);
+            }
+            c2pa_release_string(result);
+        });
+    }
+
+    return 0;
+}
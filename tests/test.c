@@ -10,27 +10,251 @@
 // specific language governing permissions and limitations under
 // each license.
 
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include "../include/c2pa.h"
 #include "unit_test.h"
 
+// stream callbacks backed by a stdio FILE, for testing c2pa_create_stream
+intptr_t file_reader(struct StreamContext *context, uint8_t *data, uintptr_t len)
+{
+    return fread(data, 1, len, (FILE *)context);
+}
+
+int64_t file_seeker(struct StreamContext *context, int64_t offset, C2paSeekMode mode)
+{
+    FILE *fp = (FILE *)context;
+    int whence = (mode == Start) ? SEEK_SET : (mode == Current) ? SEEK_CUR
+                                                                : SEEK_END;
+    if (fseek(fp, (long)offset, whence) != 0)
+    {
+        return -1;
+    }
+    return ftell(fp);
+}
+
+intptr_t file_writer(struct StreamContext *context, const uint8_t *data, uintptr_t len)
+{
+    return fwrite(data, 1, len, (FILE *)context);
+}
+
+int64_t file_flusher(struct StreamContext *context)
+{
+    return fflush((FILE *)context);
+}
+
+// completion callback for c2pa_sign_file_async, records that the sign finished
+static volatile int async_done = 0;
+static volatile int async_failed = 0;
+void async_completed(const char *error, void *context)
+{
+    (void)context;
+    if (error != NULL)
+    {
+        async_failed = 1;
+    }
+    async_done = 1;
+}
+
+// completion callback for c2pa_sign_files_batch, counts completed items;
+// the batch workers call this concurrently so the counter must be atomic
+void batch_completed(uintptr_t index, const char *error, void *context)
+{
+    (void)index;
+    (void)error;
+    atomic_fetch_add((atomic_int *)context, 1);
+}
+
+// write callback for c2pa_read_file_stream, counts delivered report bytes
+intptr_t report_chunk(const uint8_t *data, size_t len, void *context)
+{
+    (void)data;
+    *(size_t *)context += len;
+    return (intptr_t)len;
+}
+
+// resource callback for c2pa_read_ingredient_file_with_options, counts
+// delivered resources
+void resource_delivered(const char *id, const uint8_t *data, size_t len, void *context)
+{
+    (void)id;
+    (void)data;
+    if (len > 0)
+    {
+        ++*(int *)context;
+    }
+}
+
+// result callback for c2pa_read_files, counts items that returned json;
+// invoked concurrently from the reader pool so the counter must be atomic
+void read_completed(uintptr_t index, const char *json, const char *error, void *context)
+{
+    (void)index;
+    (void)error;
+    if (json != NULL)
+    {
+        atomic_fetch_add((atomic_int *)context, 1);
+    }
+}
+
+// trace callback, counts the reported stage timings; spans are emitted
+// from internal worker threads too, so the counter must be atomic
+void trace_stage(C2paTraceStage stage, uint64_t start_ns, uint64_t duration_ns, uint64_t bytes, void *context)
+{
+    (void)stage;
+    (void)start_ns;
+    (void)duration_ns;
+    (void)bytes;
+    atomic_fetch_add((atomic_int *)context, 1);
+}
+
 int main(void)
 {
     char *version = c2pa_version();
     assert_contains("version", version, "c2pa-c/0.");
 
+    atomic_int trace_events = 0;
+    c2pa_set_trace_callback(trace_stage, &trace_events);
+
+    if (c2pa_has_manifest("tests/fixtures/C.jpg") != 1 ||
+        c2pa_has_manifest("tests/fixtures/A.jpg") != 0 ||
+        c2pa_has_manifest("tests/fixtures/Z.jpg") != -1)
+    {
+        fprintf(stderr, "FAILED c2pa_has_manifest\n");
+        exit(1);
+    }
+    printf("PASSED: c2pa_has_manifest\n");
+
     char *result1 = c2pa_read_file("tests/fixtures/C.jpg", NULL);
     assert_not_null("c2pa_read_file_no_data_dir", result1);
 
+    if (c2pa_read_file("tests/fixtures/A.jpg", NULL) != NULL ||
+        c2pa_error_code() != C2paErrorManifestNotFound)
+    {
+        fprintf(stderr, "FAILED c2pa_error_code\n");
+        exit(1);
+    }
+    printf("PASSED: c2pa_error_code\n");
+
+    c2pa_set_mmap_read(true);
+    result1 = c2pa_read_file("tests/fixtures/C.jpg", NULL);
+    c2pa_set_mmap_read(false);
+    assert_contains("c2pa_read_file_mmap", result1, "C.jpg");
+
+    if (c2pa_settings_load("{\"mmap_read\": true}") != 0 ||
+        c2pa_settings_set("no_such_setting", 1) != -1 ||
+        c2pa_error_code() != C2paErrorNotSupported)
+    {
+        fprintf(stderr, "FAILED c2pa_settings\n");
+        exit(1);
+    }
+    c2pa_settings_reset();
+    printf("PASSED: c2pa_settings\n");
+
+    // the report arrives through the callback in chunks instead of one
+    // giant string
+    size_t streamed_bytes = 0;
+    if (c2pa_read_file_stream("tests/fixtures/C.jpg", report_chunk, &streamed_bytes) != 0 ||
+        streamed_bytes == 0)
+    {
+        fprintf(stderr, "FAILED c2pa_read_file_stream\n");
+        exit(1);
+    }
+    printf("PASSED: c2pa_read_file_stream\n");
+
+    char *selected = c2pa_read_file_selected("tests/fixtures/C.jpg", "title,claim_generator");
+    assert_contains("c2pa_read_file_selected", selected, "title");
+
     char *result = c2pa_read_file("tests/fixtures/C.jpg", "target/tmp");
     assert_not_null("c2pa_read_file", result);
 
+    long c_jpg_size = 0;
+    char *c_jpg = load_binary_file("tests/fixtures/C.jpg", &c_jpg_size);
+    result = c2pa_read_buffer((const uint8_t *)c_jpg, (size_t)c_jpg_size, "image/jpeg");
+    assert_not_null("c2pa_read_buffer", result);
+    free(c_jpg);
+
+    FILE *fp = fopen("tests/fixtures/C.jpg", "rb");
+    C2paStream *stream = c2pa_create_stream((struct StreamContext *)fp, file_reader, file_seeker, file_writer, file_flusher);
+    result = c2pa_read_stream(stream, "image/jpeg");
+    assert_not_null("c2pa_read_stream", result);
+    c2pa_release_stream(stream);
+    fclose(fp);
+
+    const char *read_paths[] = {"tests/fixtures/C.jpg", "tests/fixtures/A.jpg", "tests/fixtures/Z.jpg"};
+    atomic_int read_count = 0;
+    if (c2pa_read_files(read_paths, 3, 2, read_completed, &read_count) != 1 || read_count != 1)
+    {
+        fprintf(stderr, "FAILED c2pa_read_files\n");
+        exit(1);
+    }
+    printf("PASSED: c2pa_read_files\n");
+
+    C2paReaderCache *cache = c2pa_reader_cache_create(16);
+    result = c2pa_read_file_cached(cache, "tests/fixtures/C.jpg");
+    c2pa_release_string(result);
+    result = c2pa_read_file_cached(cache, "tests/fixtures/C.jpg");
+    uint64_t cache_hits = 0, cache_misses = 0;
+    c2pa_reader_cache_stats(cache, &cache_hits, &cache_misses);
+    c2pa_reader_cache_free(cache);
+    if (result == NULL || cache_hits != 1 || cache_misses != 1)
+    {
+        fprintf(stderr, "FAILED c2pa_read_file_cached\n");
+        exit(1);
+    }
+    c2pa_release_string(result);
+    printf("PASSED: c2pa_read_file_cached\n");
+
+    size_t cbor_len = 0;
+    uint8_t *cbor = c2pa_read_file_cbor("tests/fixtures/C.jpg", &cbor_len);
+    if (cbor == NULL || cbor_len == 0)
+    {
+        fprintf(stderr, "FAILED c2pa_read_file_cbor\n");
+        exit(1);
+    }
+    c2pa_release_buffer(cbor, cbor_len);
+    printf("PASSED: c2pa_read_file_cbor\n");
+
+    // query the required size, then read into a stack buffer
+    int64_t required = c2pa_read_file_into("tests/fixtures/C.jpg", NULL, NULL, 0);
+    char into_buf[65536];
+    if (required <= 0 || (size_t)required > sizeof(into_buf) || c2pa_read_file_into("tests/fixtures/C.jpg", NULL, into_buf, sizeof(into_buf)) != required || strlen(into_buf) + 1 != (size_t)required)
+    {
+        fprintf(stderr, "FAILED c2pa_read_file_into\n");
+        exit(1);
+    }
+    // a too-small buffer still reports the required size and writes nothing
+    char tiny_buf[4] = "abc";
+    if (c2pa_read_file_into("tests/fixtures/C.jpg", NULL, tiny_buf, sizeof(tiny_buf)) != required || strcmp(tiny_buf, "abc") != 0)
+    {
+        fprintf(stderr, "FAILED c2pa_read_file_into small buffer\n");
+        exit(1);
+    }
+    printf("PASSED: c2pa_read_file_into\n");
+
     result = c2pa_read_ingredient_file("tests/fixtures/C.jpg", "target/ingredient");
     assert_not_null("c2pa_ingredient_from_file", result);
 
+    result = c2pa_read_ingredient_file_with_flags("tests/fixtures/C.jpg", "target/ingredient",
+                                                  C2PA_READ_SKIP_RESOURCES | C2PA_READ_SKIP_THUMBNAILS);
+    assert_not_null("c2pa_ingredient_from_file_skip_resources", result);
+
+    // resources delivered through the callback, never written to disk
+    int resource_count = 0;
+    result = c2pa_read_ingredient_file_with_options("tests/fixtures/A.jpg", NULL, 0, 256, 0,
+                                                    resource_delivered, &resource_count);
+    assert_not_null("c2pa_read_ingredient_file_with_options", result);
+    if (resource_count < 1)
+    {
+        fprintf(stderr, "FAILED c2pa_read_ingredient_file_with_options: no resources delivered\n");
+        exit(1);
+    }
+    printf("PASSED: c2pa_read_ingredient_file_with_options\n");
+
     char *certs = load_file("tests/fixtures/es256_certs.pem");
     char *private_key = load_file("tests/fixtures/es256_private.key");
 
@@ -39,15 +263,220 @@ int main(void)
     // create a sign_info struct
     C2paSignerInfo sign_info = {.alg = "es256", .sign_cert = certs, .private_key = private_key, .ta_url = "http://timestamp.digicert.com"};
 
+    // cache timestamp authority responses for the duration of the sign tests
+    c2pa_set_timestamp_cache_ttl(30);
+
     result = c2pa_sign_file("tests/fixtures/C.jpg", "target/tmp/earth.jpg", manifest, &sign_info, "tests/fixtures");
     assert_not_null("c2pa_sign_file_ok", result);
 
+    long a_jpg_size = 0;
+    char *a_jpg = load_binary_file("tests/fixtures/A.jpg", &a_jpg_size);
+    size_t signed_len = 0;
+    uint8_t *signed_asset = c2pa_sign_buffer((const uint8_t *)a_jpg, (size_t)a_jpg_size, "image/jpeg", manifest, &sign_info, &signed_len);
+    if (signed_asset == NULL || signed_len == 0)
+    {
+        char *err = c2pa_error();
+        fprintf(stderr, "FAILED c2pa_sign_buffer: %s\n", err);
+        c2pa_release_string(err);
+        exit(1);
+    }
+    printf("PASSED: c2pa_sign_buffer\n");
+    c2pa_release_buffer(signed_asset, signed_len);
+    free(a_jpg);
+
+    C2paSigner *signer = c2pa_signer_create(&sign_info);
+    if (signer == NULL)
+    {
+        char *err = c2pa_error();
+        fprintf(stderr, "FAILED c2pa_signer_create: %s\n", err);
+        c2pa_release_string(err);
+        exit(1);
+    }
+    printf("PASSED: c2pa_signer_create\n");
+
+    result = c2pa_sign_file_with_signer("tests/fixtures/C.jpg", "target/tmp/earth2.jpg", manifest, signer, "tests/fixtures");
+    assert_not_null("c2pa_sign_file_with_signer", result);
+
+    C2paIngredient *parent = c2pa_ingredient_from_file("tests/fixtures/C.jpg");
+    if (parent == NULL)
+    {
+        char *err = c2pa_error();
+        fprintf(stderr, "FAILED c2pa_ingredient_from_file: %s\n", err);
+        c2pa_release_string(err);
+        exit(1);
+    }
+    result = c2pa_sign_file_with_ingredient("tests/fixtures/C.jpg", "target/tmp/earth3.jpg", manifest, signer, parent, 0, "tests/fixtures");
+    assert_not_null("c2pa_sign_file_with_ingredient", result);
+    c2pa_ingredient_free(parent);
+
+    result = c2pa_sign_file_with_ingredient("tests/fixtures/A.jpg", "target/tmp/earth4.jpg", manifest, signer, NULL, C2PA_SIGN_SKIP_PARENT_CHECK, "tests/fixtures");
+    assert_not_null("c2pa_sign_file_skip_parent_check", result);
+
+    // data hashed signing: compose the asset with a placeholder, hash around
+    // it, then patch in the signed manifest
+    {
+        C2paSigner *dh_signer = c2pa_signer_create(&sign_info);
+        size_t placeholder_len = 0;
+        uint8_t *placeholder = c2pa_manifest_data_hash_placeholder(manifest, c2pa_signer_reserve_size(dh_signer), "image/jpeg", &placeholder_len);
+        if (placeholder == NULL)
+        {
+            char *err = c2pa_error();
+            fprintf(stderr, "FAILED c2pa_manifest_data_hash_placeholder: %s\n", err);
+            c2pa_release_string(err);
+            exit(1);
+        }
+        printf("PASSED: c2pa_manifest_data_hash_placeholder\n");
+
+        long src_size = 0;
+        unsigned char *src = (unsigned char *)load_binary_file("tests/fixtures/A.jpg", &src_size);
+        // insert just past the leading APPn segments
+        size_t offset = 2;
+        while (offset + 4 <= (size_t)src_size && src[offset] == 0xff && src[offset + 1] >= 0xe0 && src[offset + 1] <= 0xef)
+        {
+            offset += 2 + (((size_t)src[offset + 2] << 8) | src[offset + 3]);
+        }
+        FILE *composed = fopen("target/tmp/data_hashed.jpg", "wb+");
+        fwrite(src, 1, offset, composed);
+        fwrite(placeholder, 1, placeholder_len, composed);
+        fwrite(src + offset, 1, src_size - offset, composed);
+        fflush(composed);
+
+        char data_hash[256];
+        snprintf(data_hash, sizeof(data_hash),
+                 "{\"exclusions\": [{\"start\": %zu, \"length\": %zu}], \"name\": \"jumbf manifest\", \"alg\": \"sha256\", \"hash\": [], \"pad\": []}",
+                 offset, placeholder_len);
+        size_t manifest_len = 0;
+        uint8_t *signed_manifest = c2pa_sign_data_hashed_manifest(manifest, dh_signer, "image/jpeg", data_hash, "target/tmp/data_hashed.jpg", &manifest_len);
+        if (signed_manifest == NULL || manifest_len != placeholder_len)
+        {
+            char *err = c2pa_error();
+            fprintf(stderr, "FAILED c2pa_sign_data_hashed_manifest: %s\n", err);
+            c2pa_release_string(err);
+            exit(1);
+        }
+        fseek(composed, offset, SEEK_SET);
+        fwrite(signed_manifest, 1, manifest_len, composed);
+        fclose(composed);
+        c2pa_signer_free(dh_signer);
+        c2pa_release_buffer(signed_manifest, manifest_len);
+        c2pa_release_buffer(placeholder, placeholder_len);
+        free(src);
+
+        result = c2pa_read_file("target/tmp/data_hashed.jpg", NULL);
+        assert_not_null("c2pa_sign_data_hashed_manifest", result);
+    }
+
+    // detached signing: the asset is only read, the manifest lands in a sidecar
+    {
+        long src_size = 0;
+        char *src = load_binary_file("tests/fixtures/A.jpg", &src_size);
+        FILE *asset = fopen("target/tmp/detached.jpg", "wb");
+        fwrite(src, 1, src_size, asset);
+        fclose(asset);
+        free(src);
+
+        size_t manifest_len = 0;
+        uint8_t *manifest_bytes = c2pa_sign_file_detached("target/tmp/detached.jpg", manifest, signer, NULL, NULL, &manifest_len);
+        if (manifest_bytes == NULL || manifest_len == 0)
+        {
+            char *err = c2pa_error();
+            fprintf(stderr, "FAILED c2pa_sign_file_detached: %s\n", err);
+            c2pa_release_string(err);
+            exit(1);
+        }
+        c2pa_release_buffer(manifest_bytes, manifest_len);
+
+        result = c2pa_read_file("target/tmp/detached.jpg", NULL);
+        assert_not_null("c2pa_sign_file_detached", result);
+    }
+
+    C2paManifestTemplate *template = c2pa_manifest_compile(manifest);
+    if (template == NULL)
+    {
+        char *err = c2pa_error();
+        fprintf(stderr, "FAILED c2pa_manifest_compile: %s\n", err);
+        c2pa_release_string(err);
+        exit(1);
+    }
+    result = c2pa_sign_file_with_template("tests/fixtures/A.jpg", "target/tmp/earth5.jpg", template, "{\"title\": \"overlay.jpg\"}", signer, C2PA_SIGN_SKIP_PARENT_CHECK, "tests/fixtures");
+    assert_not_null("c2pa_sign_file_with_template", result);
+    c2pa_manifest_template_free(template);
+
+    // incremental re-sign: the updated manifest reuses the existing hard
+    // binding, so the asset is not re-hashed
+    result = c2pa_resign_file("target/tmp/earth5.jpg", "target/tmp/resigned.jpg", manifest, signer, "tests/fixtures");
+    assert_not_null("c2pa_resign_file", result);
+    result = c2pa_read_file("target/tmp/resigned.jpg", NULL);
+    assert_contains("c2pa_resign_file read", result, "overlay.jpg");
+    c2pa_signer_free(signer);
+
+    if (c2pa_sign_file_async("tests/fixtures/A.jpg", "target/tmp/earth6.jpg", manifest, &sign_info, "tests/fixtures", async_completed, NULL) != 0)
+    {
+        fprintf(stderr, "FAILED c2pa_sign_file_async: could not start\n");
+        exit(1);
+    }
+    for (int i = 0; i < 600 && !async_done; i++)
+    {
+        struct timespec ts = {0, 100000000}; // 100ms
+        nanosleep(&ts, NULL);
+    }
+    if (!async_done || async_failed)
+    {
+        fprintf(stderr, "FAILED c2pa_sign_file_async\n");
+        exit(1);
+    }
+    printf("PASSED: c2pa_sign_file_async\n");
+
+    const char *batch_sources[] = {"tests/fixtures/C.jpg", "tests/fixtures/A.jpg"};
+    const char *batch_dests[] = {"target/tmp/batch_C.jpg", "target/tmp/batch_A.jpg"};
+    atomic_int batch_count = 0;
+    int64_t batch_ok = c2pa_sign_files_batch(batch_sources, batch_dests, 2, manifest, &sign_info, 0, batch_completed, &batch_count);
+    if (batch_ok != 2 || batch_count != 2)
+    {
+        char *err = c2pa_error();
+        fprintf(stderr, "FAILED c2pa_sign_files_batch: %s\n", err);
+        c2pa_release_string(err);
+        exit(1);
+    }
+    printf("PASSED: c2pa_sign_files_batch\n");
+
+    // a long lived session: workers hold pre-warmed signers and queued
+    // requests overlap across them
+    C2paSignerSession *session = c2pa_signer_session_create(&sign_info, 2);
+    if (session == NULL ||
+        c2pa_signer_session_sign_file(session, "tests/fixtures/C.jpg", "target/tmp/session_C.jpg", manifest, NULL, NULL) != 0 ||
+        c2pa_signer_session_sign_file(session, "tests/fixtures/A.jpg", "target/tmp/session_A.jpg", manifest, NULL, NULL) != 0 ||
+        c2pa_signer_session_wait(session) != 2)
+    {
+        char *err = c2pa_error();
+        fprintf(stderr, "FAILED c2pa_signer_session: %s\n", err);
+        c2pa_release_string(err);
+        exit(1);
+    }
+    c2pa_signer_session_free(session);
+    printf("PASSED: c2pa_signer_session\n");
+
+    c2pa_set_timestamp_cache_ttl(0);
+
     result = c2pa_sign_file("tests/fixtures/foo.jpg", "target/tmp/earth.jpg", manifest, &sign_info, "tests/fixtures");
     assert_null("c2pa_sign_file_not_found", result, "FileNotFound");
+    if (c2pa_error_code() != C2paErrorFileNotFound)
+    {
+        fprintf(stderr, "FAILED c2pa_error_code_not_found\n");
+        exit(1);
+    }
 
     result = c2pa_sign_file("tests/fixtures/es256_certs.pem", "target/tmp/earth.jpg", manifest, &sign_info, "tests/fixtures");
     assert_null("c2pa_sign_file_not_supported", result, "NotSupported");
 
+    c2pa_set_trace_callback(NULL, NULL);
+    if (trace_events == 0)
+    {
+        fprintf(stderr, "FAILED c2pa_set_trace_callback\n");
+        exit(1);
+    }
+    printf("PASSED: c2pa_set_trace_callback\n");
+
     free(certs);
     free(private_key);
 }
\ No newline at end of file
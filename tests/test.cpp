@@ -15,12 +15,12 @@
 #include <string.h>
 #include "../include/c2pa.hpp"
 
-// assert that c2pa_str contains substr or exit
-void assert_contains(const char *what, std::string str, const char *substr)
+// assert that str contains substr or exit
+void assert_contains(const char *what, std::string_view str, const char *substr)
 {
-    if (strstr(str.c_str(), substr) == NULL)
+    if (str.find(substr) == std::string_view::npos)
     {
-        fprintf(stderr, "FAILED %s: %s not found in %s\n", what, str.c_str(), substr);
+        fprintf(stderr, "FAILED %s: %s not found in %s\n", what, std::string(str).c_str(), substr);
         exit(1);
     }
     printf("PASSED: %s\n", what);
@@ -33,6 +33,41 @@ int main()
     auto version = C2pa::version();
     assert_contains("C2pa::version", version, "c2pa-c/0.");
 
+    try
+    {
+        // probe for manifest presence without reading the whole store
+        if (!C2pa::has_manifest("tests/fixtures/C.jpg") || C2pa::has_manifest("tests/fixtures/A.jpg"))
+        {
+            cout << "Failed: C2pa::has_manifest" << endl;
+            return (1);
+        }
+        printf("PASSED: C2pa::has_manifest\n");
+    }
+    catch (C2pa::Exception e)
+    {
+        cout << "Failed: C2pa::has_manifest: " << e.what() << endl;
+        return (1);
+    };
+
+    try
+    {
+        // apply settings for the scope of the read; defaults are restored
+        // when the instance goes out of scope
+        C2pa::Settings settings("{\"mmap_read\": true}");
+        auto mapped_json = C2pa::read_file("tests/fixtures/C.jpg");
+        if (!mapped_json.has_value())
+        {
+            cout << "Failed: C2pa::Settings: mapped_json is empty" << endl;
+            return (1);
+        }
+        printf("PASSED: C2pa::Settings\n");
+    }
+    catch (C2pa::Exception e)
+    {
+        cout << "Failed: C2pa::Settings: " << e.what() << endl;
+        return (1);
+    };
+
     try
     {
         // read a file with a valid manifest
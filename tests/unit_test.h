@@ -48,6 +48,36 @@ char *load_file(const char *filename)
     return buffer;
 }
 
+// load a binary file into a buffer for testing, returning its size in size
+char *load_binary_file(const char *filename, long *size)
+{
+    char *buffer = NULL;
+    FILE *fp = fopen(filename, "rb"); // Open file in binary mode
+
+    if (fp != NULL)
+    {
+        // Determine file size
+        fseek(fp, 0L, SEEK_END);
+        *size = ftell(fp);
+        rewind(fp);
+
+        // Allocate buffer
+        buffer = (char *)malloc(*size);
+        if (buffer != NULL)
+        {
+            // Read file into buffer
+            fread(buffer, 1, *size, fp);
+        }
+        fclose(fp);
+    }
+    else
+    {
+        fprintf(stderr, "FAILED: unable to open file %s\n", filename);
+        exit(1);
+    }
+    return buffer;
+}
+
 // these functions implement a poor person's test framework
 void passed(const char *what, char *c2pa_str)
 {